@@ -0,0 +1,326 @@
+#include "Cpu.hpp"
+#include "Mem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Microbenchmarks dos caminhos críticos (Cpu::next, modos de endereçamento e
+// Memory::read/write). Cada benchmark roda algumas vezes sem medição
+// (aquecimento) e depois "reps" vezes; o relatório mostra a mediana, o
+// mínimo, o máximo e o desvio padrão do tempo por operação.
+
+struct Options {
+  uint64_t reps{10};
+  uint64_t warmup{2};
+  uint64_t instructions{2000000};
+  uint64_t accesses{4000000};
+  std::string filter;
+  bool blockCache{false};
+  bool jit{false};
+  bool csv{false};
+};
+
+// Executa uma repetição e retorna o número de operações feitas
+struct Benchmark {
+  std::string group;
+  std::string name;
+  std::function<uint64_t()> run;
+};
+
+// Evita que o compilador descarte as leituras
+volatile uint8_t sink;
+
+void usage(const char *name) {
+  std::cerr
+      << "Usage: " << name << " [options]\n"
+      << "  -r, --reps <n>           measured repetitions (default 10)\n"
+      << "  -w, --warmup <n>         unmeasured repetitions (default 2)\n"
+      << "  -i, --instructions <n>   instructions per CPU repetition\n"
+      << "                           (default 2000000)\n"
+      << "  -m, --accesses <n>       accesses per memory repetition\n"
+      << "                           (default 4000000)\n"
+      << "  -f, --filter <text>      run only benchmarks whose group or name\n"
+      << "                           contains text\n"
+      << "      --block-cache        run the CPU from the block cache\n"
+      << "      --jit                run hot CPU blocks as native code\n"
+      << "      --csv                print results as CSV\n";
+}
+
+bool parseNumber(const char *text, uint64_t &value) {
+  char *end = nullptr;
+  value = strtoull(text, &end, 0);
+  return end != text && *end == '\0';
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    uint64_t value;
+    if ((arg == "-r" || arg == "--reps") && hasValue &&
+        parseNumber(argv[++i], value) && value > 0) {
+      options.reps = value;
+    } else if ((arg == "-w" || arg == "--warmup") && hasValue &&
+               parseNumber(argv[++i], value)) {
+      options.warmup = value;
+    } else if ((arg == "-i" || arg == "--instructions") && hasValue &&
+               parseNumber(argv[++i], value) && value > 0) {
+      options.instructions = value;
+    } else if ((arg == "-m" || arg == "--accesses") && hasValue &&
+               parseNumber(argv[++i], value) && value > 0) {
+      options.accesses = value;
+    } else if ((arg == "-f" || arg == "--filter") && hasValue) {
+      options.filter = argv[++i];
+    } else if (arg == "--block-cache") {
+      options.blockCache = true;
+    } else if (arg == "--jit") {
+      options.jit = true;
+    } else if (arg == "--csv") {
+      options.csv = true;
+    } else {
+      std::cerr << "Invalid argument \"" << arg << "\"\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Máquina com "body" repetido 64 vezes em $8000 seguido de JMP $8000 (1 JMP
+// a cada 64 repetições; fora da RAM para o programa não ser espelhado).
+// Ponteiros e dados usados pelos benchmarks: ($10) -> $0300,
+// ($20) -> $8000 e sub-rotina (RTS) em $9000.
+struct Machine {
+  Memory memory;
+  Cpu cpu;
+
+  Machine(const Options &options, const std::vector<uint8_t> &body)
+      : cpu(memory) {
+    const uint16_t loop = 0x8000;
+    std::vector<uint8_t> program;
+    for (int i = 0; i < 64; i++) {
+      program.insert(program.end(), body.begin(), body.end());
+    }
+    program.push_back(0x4C);
+    program.push_back(loop & 0xFF);
+    program.push_back(loop >> 8);
+
+    memory.enableSaveStatusToFile(false);
+    memory.setRandomSeed(1);
+    memory.fillZeroData();
+    memory.loadProgram(program, loop);
+    memory.write(0x0010, 0x00);
+    memory.write(0x0011, 0x03);
+    memory.write(0x0020, loop & 0xFF);
+    memory.write(0x0021, loop >> 8);
+    memory.write(0x9000, 0x60);
+
+    cpu.setAsmAddress(loop);
+    // X = Y = 1 e Z limpo (BNE sempre desvia, BEQ nunca)
+    cpu.setState({loop, 0xFF, 0x01, 0x01, 0x01, 0x30});
+    // Os laços não escrevem na memória: não podem ser pulados
+    cpu.enableIdleSkip(false);
+    if (options.jit) {
+      cpu.enableJit(true);
+    } else if (options.blockCache) {
+      cpu.enableBlockCache(true);
+    }
+  }
+};
+
+void addCpuBenchmark(std::vector<Benchmark> &benchmarks,
+                     const Options &options, const std::string &group,
+                     const std::string &name,
+                     const std::vector<uint8_t> &body) {
+  // Máquina compartilhada entre as repetições (o cache de blocos e o Jit
+  // ficam aquecidos)
+  std::shared_ptr<Machine> machine =
+      std::make_shared<Machine>(options, body);
+  const uint64_t instructions = options.instructions;
+  benchmarks.push_back({group, name, [machine, instructions]() {
+                          return machine->cpu.runInstructions(instructions)
+                              .instructions;
+                        }});
+}
+
+// Leituras/escritas percorrendo [begin, begin + size) ciclicamente
+void addMemoryBenchmark(std::vector<Benchmark> &benchmarks,
+                        const Options &options, const std::string &name,
+                        uint16_t begin, uint32_t size, bool write) {
+  std::shared_ptr<Memory> memory = std::make_shared<Memory>();
+  memory->enableSaveStatusToFile(false);
+  memory->setRandomSeed(1);
+  memory->fillZeroData();
+  const uint64_t accesses = options.accesses;
+  benchmarks.push_back(
+      {"memory", name, [memory, begin, size, write, accesses]() {
+         uint8_t sum = 0;
+         uint32_t offset = 0;
+         for (uint64_t i = 0; i < accesses; i++) {
+           const uint16_t address = begin + offset;
+           if (write) {
+             memory->write(address, sum++);
+           } else {
+             sum += memory->read(address);
+           }
+           if (++offset == size) {
+             offset = 0;
+           }
+         }
+         sink = sum;
+         return accesses;
+       }});
+}
+
+std::vector<Benchmark> createBenchmarks(const Options &options) {
+  std::vector<Benchmark> benchmarks;
+  auto cpu = [&](const std::string &group, const std::string &name,
+                 const std::vector<uint8_t> &body) {
+    addCpuBenchmark(benchmarks, options, group, name, body);
+  };
+
+  // Um modo por benchmark (LDA quando possível)
+  cpu("mode", "imp (INX)", {0xE8});
+  cpu("mode", "acc (ASL A)", {0x0A});
+  cpu("mode", "imm (LDA #)", {0xA9, 0x10});
+  cpu("mode", "zpg (LDA)", {0xA5, 0x10});
+  cpu("mode", "zpg,X (LDA)", {0xB5, 0x10});
+  cpu("mode", "zpg,Y (LDX)", {0xB6, 0x10});
+  cpu("mode", "abs (LDA)", {0xAD, 0x00, 0x03});
+  cpu("mode", "abs,X (LDA)", {0xBD, 0x00, 0x03});
+  cpu("mode", "abs,X cross (LDA)", {0xBD, 0xFF, 0x03});
+  cpu("mode", "abs,Y (LDA)", {0xB9, 0x00, 0x03});
+  cpu("mode", "(ind,X) (LDA)", {0xA1, 0x0F});
+  cpu("mode", "(ind),Y (LDA)", {0xB1, 0x10});
+  cpu("mode", "ind (JMP)", {0x6C, 0x20, 0x00});
+  cpu("mode", "rel taken (BNE)", {0xD0, 0x00});
+  cpu("mode", "rel not taken (BEQ)", {0xF0, 0x00});
+
+  // Famílias de opcodes (sequências que mantêm o estado estável)
+  cpu("family", "load/store", {0xA5, 0x10, 0x85, 0x12, 0xA6, 0x12, 0x86,
+                               0x13});
+  cpu("family", "alu", {0x69, 0x01, 0xE9, 0x01, 0x29, 0xFF, 0x09, 0x00, 0x49,
+                        0x00, 0xC9, 0x00});
+  cpu("family", "shift/rotate (mem)", {0x06, 0x12, 0x26, 0x12, 0x46, 0x12,
+                                       0x66, 0x12});
+  cpu("family", "inc/dec (mem)", {0xE6, 0x12, 0xC6, 0x12});
+  cpu("family", "inc/dec (reg)", {0xE8, 0xCA, 0xC8, 0x88});
+  cpu("family", "transfer", {0xAA, 0x8A, 0xA8, 0x98});
+  cpu("family", "flags", {0x18, 0x38, 0xB8, 0xEA});
+  cpu("family", "stack", {0x48, 0x68, 0x08, 0x28});
+  cpu("family", "jsr/rts", {0x20, 0x00, 0x90});
+
+  // Faixas do mapa de memória (escritas abaixo de $2000 são espelhadas)
+  addMemoryBenchmark(benchmarks, options, "read ram", 0x0200, 0x0600, false);
+  addMemoryBenchmark(benchmarks, options, "read mirror", 0x0800, 0x1800,
+                     false);
+  addMemoryBenchmark(benchmarks, options, "read i/o", 0x2000, 0x2020, false);
+  addMemoryBenchmark(benchmarks, options, "read rom", 0x8000, 0x8000, false);
+  addMemoryBenchmark(benchmarks, options, "read $FE", RANDOM_ADDRESS, 1,
+                     false);
+  addMemoryBenchmark(benchmarks, options, "write ram", 0x0200, 0x0600, true);
+  addMemoryBenchmark(benchmarks, options, "write mirror", 0x0800, 0x1800,
+                     true);
+  addMemoryBenchmark(benchmarks, options, "write i/o", 0x2000, 0x2020, true);
+  addMemoryBenchmark(benchmarks, options, "write rom", 0x8000, 0x8000, true);
+  return benchmarks;
+}
+
+struct Statistics {
+  double median;
+  double min;
+  double max;
+  double mean;
+  double stddev;
+};
+
+Statistics computeStatistics(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  Statistics stats;
+  const size_t n = samples.size();
+  stats.median = n % 2 == 1 ? samples[n / 2]
+                            : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  stats.min = samples.front();
+  stats.max = samples.back();
+  double sum = 0;
+  for (double sample : samples) {
+    sum += sample;
+  }
+  stats.mean = sum / n;
+  double variance = 0;
+  for (double sample : samples) {
+    variance += (sample - stats.mean) * (sample - stats.mean);
+  }
+  stats.stddev = n > 1 ? std::sqrt(variance / (n - 1)) : 0;
+  return stats;
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (options.csv) {
+    std::cout << "group,name,reps,ops,ns_median,ns_min,ns_max,ns_mean,"
+                 "ns_stddev,mops\n";
+  } else {
+    std::cout << "| Warmup: " << options.warmup << " | Reps: " << options.reps
+              << " | Dispatch: "
+              << (options.jit ? "jit"
+                              : options.blockCache ? "block cache"
+                                                   : "interpreter")
+              << "\n| " << std::left << std::setw(7) << "group"
+              << std::setw(22) << "benchmark" << std::right << std::setw(9)
+              << "ns/op" << std::setw(9) << "min" << std::setw(9) << "max"
+              << std::setw(9) << "stddev" << std::setw(10) << "Mops/s"
+              << "\n";
+  }
+
+  for (Benchmark &benchmark : createBenchmarks(options)) {
+    if (!options.filter.empty() &&
+        benchmark.group.find(options.filter) == std::string::npos &&
+        benchmark.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+
+    for (uint64_t i = 0; i < options.warmup; i++) {
+      benchmark.run();
+    }
+    std::vector<double> samples;
+    uint64_t ops = 0;
+    for (uint64_t i = 0; i < options.reps; i++) {
+      auto begin = std::chrono::steady_clock::now();
+      ops = benchmark.run();
+      double ns = std::chrono::duration<double, std::nano>(
+                      std::chrono::steady_clock::now() - begin)
+                      .count();
+      samples.push_back(ops > 0 ? ns / ops : 0);
+    }
+
+    // Mops/s: instruções por segundo nos benchmarks da CPU
+    const Statistics stats = computeStatistics(samples);
+    const double mops = stats.median > 0 ? 1e3 / stats.median : 0;
+    if (options.csv) {
+      std::cout << benchmark.group << "," << benchmark.name << ","
+                << options.reps << "," << ops << "," << stats.median << ","
+                << stats.min << "," << stats.max << "," << stats.mean << ","
+                << stats.stddev << "," << mops << "\n";
+      continue;
+    }
+    std::cout << "| " << std::left << std::setw(7) << benchmark.group
+              << std::setw(22) << benchmark.name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(9) << stats.median
+              << std::setw(9) << stats.min << std::setw(9) << stats.max
+              << std::setw(9) << stats.stddev << std::setprecision(1)
+              << std::setw(10) << mops << "\n";
+  }
+  return 0;
+}
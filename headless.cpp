@@ -0,0 +1,477 @@
+#include "Cpu.hpp"
+#include "Differential.hpp"
+#include "Farm.hpp"
+#include "IntervalTimer.hpp"
+#include "Lockstep.hpp"
+#include "Mapper.hpp"
+#include "Mem.hpp"
+#include "TraceCompare.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// Emulador sem interface gráfica: carrega o programa, executa um orçamento
+// de instruções/ciclos e imprime registradores, ciclos e desempenho.
+
+struct Options {
+  std::string path;
+  uint16_t address{0x0600};
+  bool hasAddress{false};
+  uint64_t instructions{10000000};
+  uint64_t cycles{0};
+  bool untilBRK{false};
+  bool untilPC{false};
+  uint16_t stopPC{};
+  bool blockCache{false};
+  bool jit{false};
+  bool idleSkip{true};
+  uint64_t nmiPeriod{0};
+  bool differential{false};
+  uint64_t farmJobs{0};
+  uint64_t threads{0};
+  uint64_t lockstepLanes{0};
+  std::string compare;
+  bool compareCycles{true};
+  bool csv{false};
+  std::string memoryDump;
+  uint64_t memoryStatus{0};
+  std::string profile;
+  std::string trace;
+  bool hasSeed{false};
+  uint32_t seed{};
+};
+
+void usage(const char *name) {
+  std::cerr
+      << "Usage: " << name << " <program.bin|rom.nes> [options]\n"
+      << "  -a, --address <addr>     load/start address (default 0x0600; for\n"
+      << "                           .nes files, the reset vector)\n"
+      << "  -i, --instructions <n>   instruction budget (default 10000000)\n"
+      << "  -c, --cycles <n>         cycle budget (instead of instructions)\n"
+      << "      --until-brk          stop before a BRK\n"
+      << "      --until-pc <addr>    stop when PC reaches addr\n"
+      << "      --block-cache        run from the pre-decoded block cache\n"
+      << "      --jit                run hot blocks as native code\n"
+      << "      --no-idle-skip       execute idle loops instead of skipping them\n"
+      << "      --nmi-period <n>     raise an NMI every n cycles\n"
+      << "      --diff               run JIT and interpreter in lockstep\n"
+      << "                           (budget in blocks) and report divergences\n"
+      << "      --farm <n>           run n copies in parallel (seeds 1..n)\n"
+      << "      --threads <n>        farm workers (default: one per core)\n"
+      << "      --lockstep <n>       run n copies (seeds 1..n, n <= 16) in\n"
+      << "                           SIMD lockstep and report lane usage\n"
+      << "      --compare <log>      compare each instruction with a reference\n"
+      << "                           log (nestest format) and stop at the first\n"
+      << "                           divergence (-i limits the compared lines)\n"
+      << "      --ignore-cycles      do not compare CYC: with --compare\n"
+      << "      --seed <n>           seed for the random numbers read at $FE\n"
+      << "      --csv                print results as CSV\n"
+      << "      --dump-memory <file> write the final 64KB memory to file\n"
+      << "      --memory-status <ms> keep memory_status/memory.bin as a live\n"
+      << "                           memory-mapped image, flushed every ms\n"
+      << "      --profile <file>     write the execution profile (.csv/.json)\n"
+      << "                           (requires -DBYTENES_PROFILER)\n"
+      << "      --trace <file>       write the last executed instructions\n"
+      << "                           (nestest log format) when the run stops\n";
+}
+
+bool parseNumber(const char *text, uint64_t &value) {
+  char *end = nullptr;
+  value = strtoull(text, &end, 0);
+  return end != text && *end == '\0';
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    uint64_t value = 0;
+
+    if ((arg == "-a" || arg == "--address") && hasValue &&
+        parseNumber(argv[++i], value) && value <= 0xFFFF) {
+      options.address = value;
+      options.hasAddress = true;
+    } else if ((arg == "-i" || arg == "--instructions") && hasValue &&
+               parseNumber(argv[++i], value)) {
+      options.instructions = value;
+    } else if ((arg == "-c" || arg == "--cycles") && hasValue &&
+               parseNumber(argv[++i], value)) {
+      options.cycles = value;
+    } else if (arg == "--until-brk") {
+      options.untilBRK = true;
+    } else if (arg == "--until-pc" && hasValue &&
+               parseNumber(argv[++i], value) && value <= 0xFFFF) {
+      options.untilPC = true;
+      options.stopPC = value;
+    } else if (arg == "--block-cache") {
+      options.blockCache = true;
+    } else if (arg == "--jit") {
+      options.jit = true;
+    } else if (arg == "--no-idle-skip") {
+      options.idleSkip = false;
+    } else if (arg == "--nmi-period" && hasValue &&
+               parseNumber(argv[++i], value) && value > 0) {
+      options.nmiPeriod = value;
+    } else if (arg == "--diff") {
+      options.differential = true;
+    } else if (arg == "--farm" && hasValue && parseNumber(argv[++i], value) &&
+               value > 0) {
+      options.farmJobs = value;
+    } else if (arg == "--threads" && hasValue &&
+               parseNumber(argv[++i], value)) {
+      options.threads = value;
+    } else if (arg == "--lockstep" && hasValue &&
+               parseNumber(argv[++i], value) && value > 0 &&
+               value <= LOCKSTEP_LANES) {
+      options.lockstepLanes = value;
+    } else if (arg == "--compare" && hasValue) {
+      options.compare = argv[++i];
+    } else if (arg == "--ignore-cycles") {
+      options.compareCycles = false;
+    } else if (arg == "--seed" && hasValue && parseNumber(argv[++i], value) &&
+               value <= 0xFFFFFFFF) {
+      options.hasSeed = true;
+      options.seed = value;
+    } else if (arg == "--csv") {
+      options.csv = true;
+    } else if (arg == "--dump-memory" && hasValue) {
+      options.memoryDump = argv[++i];
+    } else if (arg == "--memory-status" && hasValue &&
+               parseNumber(argv[++i], value) && value > 0) {
+      options.memoryStatus = value;
+    } else if (arg == "--profile" && hasValue) {
+      options.profile = argv[++i];
+    } else if (arg == "--trace" && hasValue) {
+      options.trace = argv[++i];
+    } else if (arg[0] != '-' && options.path.empty()) {
+      options.path = arg;
+    } else {
+      std::cerr << "Invalid argument \"" << arg << "\"\n";
+      return false;
+    }
+  }
+  return !options.path.empty();
+}
+
+const char *stopReasonName(StopReason reason) {
+  switch (reason) {
+  case StopReason::BUDGET:
+    return "budget";
+  case StopReason::PREDICATE:
+    return "predicate";
+  case StopReason::BRK:
+    return "brk";
+  case StopReason::PC:
+    return "pc";
+  case StopReason::JAM:
+    return "jam";
+  }
+  return "";
+}
+
+// Programa plano em options.address ou cartucho .nes (mapper do cabeçalho,
+// início no vetor de reset); false se o cartucho não puder ser usado
+bool loadProgram(Memory &mem, const Options &options,
+                 std::unique_ptr<Cartridge> &cartridge,
+                 std::unique_ptr<Mapper> &mapper, uint16_t &start) {
+  start = options.address;
+  if (!isCartridgePath(options.path)) {
+    mem.loadMemoryFromFile(options.path, options.address);
+    return true;
+  }
+  cartridge.reset(new Cartridge(options.path));
+  mapper = createMapper(*cartridge, mem);
+  if (!mapper) {
+    std::cerr << "Could not load \"" << options.path << "\": "
+              << (cartridge->isOpen()
+                      ? "unsupported mapper " +
+                            std::to_string(cartridge->getHeader().mapper)
+                      : cartridge->getError())
+              << "\n";
+    return false;
+  }
+  if (!options.hasAddress) {
+    start = mem.peek(0xFFFC) | (mem.peek(0xFFFD) << 8);
+  }
+  return true;
+}
+
+int runDifferential(const Options &options) {
+  DifferentialRunner runner(options.path, options.address,
+                            options.hasSeed ? options.seed : time(NULL));
+  bool ok = runner.run(options.instructions);
+  runner.report(std::cout);
+  return ok ? 0 : 2;
+}
+
+// Executa o programa comparando cada instrução com o log de referência e
+// para na primeira divergência
+int runCompare(const Options &options) {
+  Memory mem;
+  mem.enableSaveStatusToFile(false);
+  if (options.hasSeed) {
+    mem.setRandomSeed(options.seed);
+  }
+  mem.fillZeroData();
+  std::unique_ptr<Cartridge> cartridge;
+  std::unique_ptr<Mapper> mapper;
+  uint16_t start;
+  if (!loadProgram(mem, options, cartridge, mapper, start)) {
+    return 1;
+  }
+
+  Cpu cpu(mem);
+  cpu.setAsmAddress(start);
+  TraceComparer comparer(cpu);
+  comparer.setCompareCycles(options.compareCycles);
+  bool ok = comparer.run(options.compare, options.instructions);
+  comparer.report(std::cout);
+  return ok ? 0 : 2;
+}
+
+// Executa cópias independentes do programa (sementes 1..n) e reporta a
+// vazão em instâncias por segundo
+int runFarm(const Options &options) {
+  std::ifstream file(options.path, std::ios::binary);
+  if (!file) {
+    std::cerr << "Could not read \"" << options.path << "\"\n";
+    return 1;
+  }
+  auto program = std::make_shared<const std::vector<uint8_t>>(
+      std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  std::vector<FarmJob> jobs(options.farmJobs);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    jobs[i].program = program;
+    jobs[i].address = options.address;
+    jobs[i].seed = i + 1;
+    jobs[i].instructions = options.instructions;
+    jobs[i].cycles = options.cycles;
+    jobs[i].jit = options.jit;
+  }
+
+  Farm farm(options.threads);
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<uint64_t> skipped(jobs.size());
+  std::vector<FarmResult> results =
+      farm.run(jobs, [&skipped](size_t job, Cpu &cpu, Memory &) {
+        skipped[job] = cpu.getSkippedInstructions();
+      });
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+          .count();
+
+  uint64_t instructions = 0;
+  uint64_t combined = 0;
+  uint64_t executed = 0;
+  for (size_t i = 0; i < results.size(); i++) {
+    const FarmResult &result = results[i];
+    instructions += result.summary.instructions;
+    executed += result.summary.instructions - skipped[i];
+    combined = combined * 31 + result.memoryHash;
+  }
+  double rate = seconds > 0 ? results.size() / seconds : 0;
+  // Sem os laços ociosos pulados, como na execução única
+  double mips = seconds > 0 ? executed / seconds / 1e6 : 0;
+
+  if (options.csv) {
+    std::cout << "instances,threads,instructions,seconds,instances_per_second,"
+                 "mips,steals,hash\n"
+              << results.size() << "," << farm.getWorkers() << ","
+              << instructions << "," << seconds << "," << rate << "," << mips
+              << "," << farm.getSteals() << "," << std::hex << combined
+              << "\n";
+    return 0;
+  }
+  std::cout << "| Instances: " << results.size()
+            << " | Threads: " << farm.getWorkers()
+            << " | Instructions: " << instructions << "\n"
+            << std::fixed << std::setprecision(3) << "| Time: " << seconds
+            << " s | " << std::setprecision(1) << rate << " instances/s | "
+            << mips << " MIPS | Steals: " << farm.getSteals() << "\n"
+            << "| Memory hash: " << std::hex << combined << "\n";
+  return 0;
+}
+
+// Executa cópias do programa em lockstep (uma instrução por pista a cada
+// passo; o orçamento de instruções é o número de passos)
+int runLockstep(const Options &options) {
+  std::ifstream file(options.path, std::ios::binary);
+  if (!file) {
+    std::cerr << "Could not read \"" << options.path << "\"\n";
+    return 1;
+  }
+  std::vector<uint8_t> program((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+  std::vector<uint32_t> seeds(options.lockstepLanes);
+  for (size_t i = 0; i < seeds.size(); i++) {
+    seeds[i] = i + 1;
+  }
+
+  Lockstep lockstep(options.lockstepLanes);
+  lockstep.load(program, options.address, seeds);
+  auto begin = std::chrono::steady_clock::now();
+  uint64_t steps = lockstep.run(options.instructions);
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+          .count();
+
+  uint64_t instructions = 0;
+  uint64_t combined = 0;
+  for (size_t lane = 0; lane < lockstep.getLanes(); lane++) {
+    instructions += lockstep.getInstructions(lane);
+    combined = combined * 31 + lockstep.getMemory(lane).hash();
+  }
+  const LockstepStats &stats = lockstep.getStats();
+  double mips = seconds > 0 ? instructions / seconds / 1e6 : 0;
+  double utilization = stats.utilization(lockstep.getLanes()) * 100;
+  double vector = stats.vectorFraction() * 100;
+
+  if (options.csv) {
+    std::cout << "lanes,steps,instructions,seconds,mips,vector_percent,"
+                 "lane_utilization_percent,divergent_steps,hash\n"
+              << lockstep.getLanes() << "," << steps << "," << instructions
+              << "," << seconds << "," << mips << "," << vector << ","
+              << utilization << "," << stats.divergentSteps << ","
+              << std::hex << combined << "\n";
+    return 0;
+  }
+  std::cout << "| Lanes: " << lockstep.getLanes() << " | Steps: " << steps
+            << " | Instructions: " << instructions << "\n"
+            << std::fixed << std::setprecision(3) << "| Time: " << seconds
+            << " s | " << std::setprecision(1) << mips << " MIPS\n"
+            << "| Vector instructions: " << vector
+            << "% | Lane utilization: " << utilization
+            << "% | Divergent steps: " << stats.divergentSteps << "\n"
+            << "| Memory hash: " << std::hex << combined << "\n";
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    usage(argv[0]);
+    return 1;
+  }
+  // Os modos abaixo carregam o arquivo como binário cru, sem mapper
+  const bool rawOnly =
+      options.differential || options.lockstepLanes > 0 || options.farmJobs > 0;
+  if (rawOnly && isCartridgePath(options.path)) {
+    std::cerr << "Cartridges are not supported with --diff, --lockstep or "
+                 "--farm\n";
+    return 1;
+  }
+  if (options.differential) {
+    return runDifferential(options);
+  }
+  if (!options.compare.empty()) {
+    return runCompare(options);
+  }
+  if (options.lockstepLanes > 0) {
+    return runLockstep(options);
+  }
+  if (options.farmJobs > 0) {
+    return runFarm(options);
+  }
+
+  Memory mem;
+  mem.enableSaveStatusToFile(options.memoryStatus > 0, options.memoryStatus);
+  if (options.hasSeed) {
+    mem.setRandomSeed(options.seed);
+  }
+  mem.fillZeroData();
+  std::unique_ptr<Cartridge> cartridge;
+  std::unique_ptr<Mapper> mapper;
+  uint16_t start;
+  if (!loadProgram(mem, options, cartridge, mapper, start)) {
+    return 1;
+  }
+
+  Cpu cpu(mem);
+  cpu.setAsmAddress(start);
+  TraceBuffer::installCrashHandler(&cpu.getTrace());
+  cpu.enableIdleSkip(options.idleSkip);
+  IntervalTimer timer(cpu, options.nmiPeriod);
+  if (options.nmiPeriod > 0) {
+    timer.start();
+  }
+  if (options.jit) {
+    cpu.enableJit(true);
+  } else if (options.blockCache) {
+    cpu.enableBlockCache(true);
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  RunSummary summary;
+  if (options.untilPC) {
+    summary = cpu.runUntilPC(options.stopPC, options.instructions);
+  } else if (options.untilBRK) {
+    summary = cpu.runUntilBRK(options.instructions);
+  } else if (options.cycles > 0) {
+    summary = cpu.runCycles(options.cycles);
+  } else {
+    summary = cpu.runInstructions(options.instructions);
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+          .count();
+  // Vazão do que foi de fato executado: os laços ociosos pulados entram nos
+  // totais, mas não custam tempo
+  const uint64_t executedInstructions =
+      summary.instructions - cpu.getSkippedInstructions();
+  const uint64_t executedCycles = summary.cycles - cpu.getSkippedCycles();
+  double mips = seconds > 0 ? executedInstructions / seconds / 1e6 : 0;
+  double mhz = seconds > 0 ? executedCycles / seconds / 1e6 : 0;
+  mem.saveMemoryStatusToFile();
+
+  if (!options.memoryDump.empty()) {
+    std::ofstream file(options.memoryDump, std::ios::binary | std::ios::trunc);
+    for (uint32_t address = 0; address <= 0xFFFF; address++) {
+      file.put(mem.peek(address));
+    }
+  }
+
+  if (!options.trace.empty() && !cpu.getTrace().dumpToFile(options.trace)) {
+    std::cerr << "Could not write \"" << options.trace << "\"\n";
+  }
+
+  if (!options.profile.empty()) {
+    if (!PROFILER_ENABLED) {
+      std::cerr << "Warning: built without -DBYTENES_PROFILER, the profile "
+                   "will be empty\n";
+    }
+    if (!cpu.getProfiler().exportToFile(options.profile)) {
+      std::cerr << "Could not write \"" << options.profile << "\"\n";
+    }
+  }
+
+  if (options.csv) {
+    std::cout << "pc,sp,ac,x,y,sr,instructions,cycles,stop,seconds,mips,mhz,"
+                 "skipped_instructions,skipped_cycles\n"
+              << std::dec << (int)cpu.getPC() << "," << (int)cpu.getSP()
+              << "," << (int)cpu.getAC() << "," << (int)cpu.getX() << ","
+              << (int)cpu.getY() << "," << (int)cpu.getSR() << ","
+              << summary.instructions << "," << summary.cycles << ","
+              << stopReasonName(summary.reason) << "," << seconds << ","
+              << mips << "," << mhz << "," << cpu.getSkippedInstructions()
+              << "," << cpu.getSkippedCycles() << "\n";
+    return 0;
+  }
+
+  cpu.showCpuStatus(0, false);
+  std::cout << std::dec << "| Instructions: " << summary.instructions
+            << " | Cycles: " << summary.cycles
+            << " | Stop: " << stopReasonName(summary.reason) << "\n"
+            << std::fixed << std::setprecision(3) << "| Time: " << seconds
+            << " s | " << std::setprecision(1) << mips << " MIPS | " << mhz
+            << " MHz (executed 6502 cycles)\n"
+            << "| Idle loops skipped: " << cpu.getSkippedInstructions()
+            << " instructions | " << cpu.getSkippedCycles() << " cycles\n";
+  return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef BLOCKCACHE_H
+#define BLOCKCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Mem.hpp"
+
+class Cpu;
+
+// Código nativo de um bloco (Jit): retorna (instruções << 32) | ciclos
+using JitCode = uint64_t (*)(Cpu *cpu);
+
+// Instrução já decodificada: opcode e bytes de operando lidos uma única vez
+struct MicroOp {
+  uint16_t pc;
+  uint16_t operand;
+  uint8_t opcode;
+};
+
+// Sequência de instruções sem desvio (basic block) iniciada em "start"
+struct Block {
+  uint16_t start;
+  std::vector<MicroOp> ops;
+
+  // Estado do Jit: execuções do bloco e código nativo (válido só na época
+  // do Jit em que foi compilado)
+  uint32_t executions{};
+  JitCode native{nullptr};
+  uint32_t nativeEpoch{};
+};
+
+// Cache de blocos decodificados, indexado pelo PC inicial. Os blocos são
+// invalidados quando Memory::write escreve em uma página que contém código
+// de algum bloco (código automodificável).
+class BlockCache : public PageWatcher {
+public:
+  BlockCache(Memory &memory);
+  ~BlockCache();
+
+  // Retorna o bloco iniciado em pc, decodificando-o em caso de miss
+  Block *lookup(uint16_t pc);
+
+  void invalidatePage(uint8_t page);
+  void clear();
+
+  void onPageWrite(uint8_t page) override;
+
+  // Incrementado a cada invalidação; quem estiver executando um bloco
+  // deve descartá-lo quando o valor mudar
+  uint64_t getGeneration() const { return generation; }
+  // Endereço do contador (lido diretamente pelo código gerado pelo Jit)
+  const uint64_t *getGenerationAddress() const { return &generation; }
+
+  uint64_t getHits() const;
+  uint64_t getMisses() const;
+  uint64_t getInvalidations() const;
+
+  // Tamanho máximo de um bloco (em instruções)
+  static const size_t MAX_BLOCK_SIZE = 32;
+
+private:
+
+  Memory &memory;
+  // Blocos indexados diretamente pelo PC inicial (alocado no primeiro uso)
+  std::vector<std::unique_ptr<Block>> blocks;
+  // PCs iniciais dos blocos que possuem código em cada página
+  std::array<std::vector<uint16_t>, 0x100> pageBlocks;
+
+  uint64_t generation{};
+  uint64_t hits{};
+  uint64_t misses{};
+  uint64_t invalidations{};
+
+  void decode(uint16_t pc, Block &block);
+};
+
+#endif
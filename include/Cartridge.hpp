@@ -0,0 +1,68 @@
+#ifndef CARTRIDGE_H
+#define CARTRIDGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RomImage.hpp"
+
+// Espelhamento das nametables da PPU
+enum class Mirroring { HORIZONTAL, VERTICAL, SINGLE_LOWER, SINGLE_UPPER, FOUR_SCREEN };
+
+// Cabeçalho iNES/NES 2.0 (16 bytes)
+struct CartridgeHeader {
+  bool nes20;
+  uint16_t mapper;
+  uint8_t submapper;
+  size_t prgRomSize;
+  size_t chrRomSize;
+  size_t prgRamSize; // Inclui a RAM com bateria
+  size_t chrRamSize;
+  Mirroring mirroring;
+  bool battery;
+  bool trainer; // 512 bytes carregados em $7000
+};
+
+// Lê o cabeçalho; false (com o motivo em "error") se não for iNES/NES 2.0
+// ou se os tamanhos não couberem em "size" bytes
+bool parseCartridgeHeader(const uint8_t *bytes, size_t size,
+                          CartridgeHeader &header, std::string &error);
+
+// Arquivo .nes mapeado em memória: PRG e CHR ROM são ponteiros para a
+// imagem (sem cópia); só a CHR RAM, quando existe, é alocada
+class Cartridge {
+public:
+  explicit Cartridge(const std::string &path);
+  ~Cartridge();
+
+  bool isOpen() const { return error.empty(); }
+  const std::string &getError() const { return error; }
+  const CartridgeHeader &getHeader() const { return header; }
+
+  const uint8_t *getPrg() const { return prg; }
+  size_t getPrgSize() const { return header.prgRomSize; }
+  // CHR ROM ou, sem ela, CHR RAM (escrita pelo mapper)
+  const uint8_t *getChr() const { return chr; }
+  size_t getChrSize() const { return chrSize; }
+  bool hasChrRam() const { return !chrRam.empty(); }
+  uint8_t *getChrRam() { return chrRam.data(); }
+  // nullptr sem trainer
+  const uint8_t *getTrainer() const { return trainer; }
+
+private:
+  RomImage image;
+  CartridgeHeader header{};
+  std::string error;
+  const uint8_t *prg{nullptr};
+  const uint8_t *chr{nullptr};
+  size_t chrSize{};
+  const uint8_t *trainer{nullptr};
+  std::vector<uint8_t> chrRam;
+};
+
+// Arquivo com extensão .nes
+bool isCartridgePath(const std::string &path);
+
+#endif
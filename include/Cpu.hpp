@@ -4,10 +4,18 @@
 #include <array>
 #include <cstdint>
 #include <sys/types.h>
+#include <vector>
 
 #include "constants.hpp"
+#include "Opcodes.hpp"
 
+#include "BlockCache.hpp"
+#include "IdleLoop.hpp"
+#include "Jit.hpp"
 #include "Mem.hpp"
+#include "Profiler.hpp"
+#include "Scheduler.hpp"
+#include "Trace.hpp"
 
 enum class Flag {
   N = (0x01 << 7), // Negative
@@ -38,28 +46,62 @@ struct MemoryAccessResult {
   bool pageCrossed; // indica se houve evento do tipo "page boundary crossed"
 };
 
-enum class ADDR_MODE {
-  IMMEDIATE,
-  ZEROPAGE,
-  ZEROPAGE_X,
-  ZEROPAGE_Y,
-  ABSOLUTE,
-  ABSOLUTE_X,
-  ABSOLUTE_Y,
-  INDIRECT,
-  INDIRECT_X,
-  INDIRECT_Y,
-  RELATIVE,
-  NONE
+// Estado visível dos registradores (para comparação entre execuções)
+struct CpuState {
+  uint16_t PC;
+  uint8_t SP;
+  uint8_t AC;
+  uint8_t X;
+  uint8_t Y;
+  uint8_t SR;
+
+  bool operator==(const CpuState &other) const {
+    return PC == other.PC && SP == other.SP && AC == other.AC &&
+           X == other.X && Y == other.Y && SR == other.SR;
+  }
+  bool operator!=(const CpuState &other) const { return !(*this == other); }
+};
+
+// Motivo do fim de uma execução em lote (Cpu::run*)
+enum class StopReason {
+  BUDGET,    // Orçamento de instruções/ciclos esgotado
+  PREDICATE, // Predicado de runUntil satisfeito
+  BRK,       // Próxima instrução é um BRK
+  PC,        // PC alcançou o endereço pedido
+  JAM,       // CPU travada por um opcode KIL/JAM
+};
+
+// Resumo de uma execução em lote
+struct RunSummary {
+  uint64_t instructions;
+  uint64_t cycles;
+  StopReason reason;
+};
+
+// Estado completo da CPU para save states (registradores, contadores e
+// linhas de interrupção). Os eventos do Scheduler pertencem aos
+// dispositivos e não fazem parte do snapshot.
+struct CpuSnapshot {
+  CpuState registers;
+  uint64_t cycles;
+  uint64_t count;
+  bool jammed;
+  bool nmiPending;
+  uint32_t irqLines;
+  // Eventos do Scheduler, em ciclos a partir de "cycles"
+  std::vector<ScheduledEvent> events;
 };
 
-struct opcodeParams {
-  ADDR_MODE addrMode;
-  uint8_t cycles;
-  uint8_t cyclesOnPageCross;
+// Resultado da execução de um bloco
+struct BlockRun {
+  uint32_t instructions;
+  uint32_t cycles;
 };
 
 class Cpu {
+  // O código gerado acessa os registradores e os thunks diretamente
+  friend class Jit;
+
 public:
   Cpu(Memory &memory);
   ~Cpu();
@@ -71,6 +113,13 @@ public:
   uint8_t getX();
   uint8_t getY();
   Memory &getMemory();
+  CpuState getState();
+  // Restaura os registradores (PC, SP, AC, X, Y e SR)
+  void setState(const CpuState &state);
+  CpuSnapshot saveSnapshot();
+  void loadSnapshot(const CpuSnapshot &snapshot);
+  // Verdadeiro depois de um opcode KIL/JAM (até o reset)
+  bool isJammed();
 
   // Mostra o status da CPU no termial
   void showCpuStatus(uint8_t index, bool showOpcodes);
@@ -78,9 +127,57 @@ public:
   // Executa a próxima instrução do programa
   uint8_t next();
 
+  // Execução em lote: um único loop, sem custo de chamada por instrução.
+  // O orçamento de ciclos pode ser ultrapassado pela última instrução.
+  RunSummary runInstructions(uint64_t count);
+  RunSummary runCycles(uint64_t cycles);
+  // Param antes de executar a instrução em "pc" / um BRK
+  RunSummary runUntilPC(uint16_t pc, uint64_t maxInstructions);
+  RunSummary runUntilBRK(uint64_t maxInstructions);
+  // Para quando predicate(cpu) for verdadeiro (testado antes de cada
+  // instrução)
+  template <typename Predicate>
+  RunSummary runUntil(Predicate predicate, uint64_t maxInstructions) {
+    return runLoop(maxInstructions, UINT64_MAX, predicate,
+                   StopReason::PREDICATE);
+  }
+
   // Reseta a execução
   void reset();
 
+  // Eventos de dispositivos marcados em ciclos da CPU (ver Scheduler.hpp).
+  // As execuções em lote param no ciclo do próximo evento, disparam os
+  // eventos vencidos e atendem as interrupções antes de continuar.
+  Scheduler &getScheduler();
+  // NMI: borda (atendida uma vez, no próximo evento)
+  void triggerNMI();
+  // IRQ: nível, por fonte (0 a 31); atendida enquanto alguma fonte estiver
+  // ativa e a flag I estiver limpa
+  void setIRQ(bool active, uint8_t source = 0);
+
+  // Executa instruções a partir do cache de blocos pré-decodificados
+  void enableBlockCache(bool enable);
+  const BlockCache &getBlockCache();
+
+  // Executa blocos quentes como código nativo (Jit); implica o cache de
+  // blocos. O interpretador continua sendo a referência e o fallback.
+  void enableJit(bool enable);
+  const Jit &getJit();
+
+  // Pula iterações de laços ociosos (ver IdleLoop.hpp) em runInstructions e
+  // runCycles, contando as instruções e os ciclos como executados.
+  // Habilitado por padrão; desligado com o profiler.
+  void enableIdleSkip(bool enable);
+  uint64_t getSkippedInstructions();
+  uint64_t getSkippedCycles();
+
+  // Contagens por opcode/PC (vazio sem -DBYTENES_PROFILER)
+  Profiler &getProfiler();
+  // Últimas instruções executadas (ver Trace.hpp)
+  const TraceBuffer &getTrace();
+  // Executa o bloco iniciado em PC (compilado ou interpretado)
+  BlockRun nextBlock();
+
   // Modos de endereçamento
   MemoryAccessResult immediate();
   MemoryAccessResult zeropage();
@@ -107,104 +204,137 @@ public:
   void flagActivationCMP(uint16_t value_1, uint8_t value_2);
 
   // Implementações das instruções
+  // Cada handler é instanciado por opcode (OP), com os parâmetros do opcode
+  // (modo de endereçamento e ciclos) conhecidos em tempo de compilação.
   using CPUCicles = uint8_t;
   // ADC (ADd with Carry)
-  CPUCicles ADC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles ADC();
   // AND (bitwise AND with accumulator)
-  CPUCicles AND(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles AND();
   // ASL (Arithmetic Shift Left)
-  CPUCicles ASL(const opcodeParams &params);
-  CPUCicles ASL_AC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles ASL();
+  template <uint8_t OP> CPUCicles ASL_AC();
   // BIT (test BITs)
-  CPUCicles BIT(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles BIT();
   // Branch Instructions
-  CPUCicles BPL(const opcodeParams &params);
-  CPUCicles BMI(const opcodeParams &params);
-  CPUCicles BVC(const opcodeParams &params);
-  CPUCicles BVS(const opcodeParams &params);
-  CPUCicles BCC(const opcodeParams &params);
-  CPUCicles BCS(const opcodeParams &params);
-  CPUCicles BNE(const opcodeParams &params);
-  CPUCicles BEQ(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles BPL();
+  template <uint8_t OP> CPUCicles BMI();
+  template <uint8_t OP> CPUCicles BVC();
+  template <uint8_t OP> CPUCicles BVS();
+  template <uint8_t OP> CPUCicles BCC();
+  template <uint8_t OP> CPUCicles BCS();
+  template <uint8_t OP> CPUCicles BNE();
+  template <uint8_t OP> CPUCicles BEQ();
   // BRK (BReaK)
-  CPUCicles BRK(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles BRK();
   // CMP (CoMPare accumulator)
-  CPUCicles CMP(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles CMP();
   // CPX (ComPare X register)
-  CPUCicles CPX(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles CPX();
   // CPY (ComPare Y register)
-  CPUCicles CPY(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles CPY();
   // DEC (DECrement memory)
-  CPUCicles DEC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles DEC();
   // EOR (bitwise Exclusive OR)
-  CPUCicles EOR(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles EOR();
   // Flag (Processor Status) Instructions
-  CPUCicles CLC(const opcodeParams &params);
-  CPUCicles SEC(const opcodeParams &params);
-  CPUCicles CLI(const opcodeParams &params);
-  CPUCicles SEI(const opcodeParams &params);
-  CPUCicles CLV(const opcodeParams &params);
-  CPUCicles CLD(const opcodeParams &params);
-  CPUCicles SED(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles CLC();
+  template <uint8_t OP> CPUCicles SEC();
+  template <uint8_t OP> CPUCicles CLI();
+  template <uint8_t OP> CPUCicles SEI();
+  template <uint8_t OP> CPUCicles CLV();
+  template <uint8_t OP> CPUCicles CLD();
+  template <uint8_t OP> CPUCicles SED();
   // INC (INCrement memory)
-  CPUCicles INC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles INC();
   // JMP (JuMP)
-  CPUCicles JMP(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles JMP();
   // JSR (Jump to SubRoutine)
-  CPUCicles JSR(const opcodeParams &params);
-  // LDA (LoaD Accumulator)
-  CPUCicles LDA_old(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles JSR();
   // LDA (LoaD Accumulator)
-  CPUCicles LDA(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles LDA();
   // LDX (LoaD X register)
-  CPUCicles LDX(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles LDX();
   // LDY (LoaD Y register)
-  CPUCicles LDY(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles LDY();
   // LSR (Logical Shift Right)
-  CPUCicles LSR(const opcodeParams &params);
-  CPUCicles LSR_AC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles LSR();
+  template <uint8_t OP> CPUCicles LSR_AC();
   // NOP (No OPeration)
-  CPUCicles NOP(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles NOP();
   // ORA (bitwise OR with Accumulator)
-  CPUCicles ORA(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles ORA();
   // Register Instructions
-  CPUCicles TAX(const opcodeParams &params);
-  CPUCicles TXA(const opcodeParams &params);
-  CPUCicles DEX(const opcodeParams &params);
-  CPUCicles INX(const opcodeParams &params);
-  CPUCicles TAY(const opcodeParams &params);
-  CPUCicles TYA(const opcodeParams &params);
-  CPUCicles DEY(const opcodeParams &params);
-  CPUCicles INY(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles TAX();
+  template <uint8_t OP> CPUCicles TXA();
+  template <uint8_t OP> CPUCicles DEX();
+  template <uint8_t OP> CPUCicles INX();
+  template <uint8_t OP> CPUCicles TAY();
+  template <uint8_t OP> CPUCicles TYA();
+  template <uint8_t OP> CPUCicles DEY();
+  template <uint8_t OP> CPUCicles INY();
   // ROL (ROtate Left)
-  CPUCicles ROL(const opcodeParams &params);
-  CPUCicles ROL_AC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles ROL();
+  template <uint8_t OP> CPUCicles ROL_AC();
   // ROR (ROtate Right)
-  CPUCicles ROR(const opcodeParams &params);
-  CPUCicles ROR_AC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles ROR();
+  template <uint8_t OP> CPUCicles ROR_AC();
   // RTI (ReTurn from Interrupt)
-  CPUCicles RTI(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles RTI();
   // RTS (ReTurn from Subroutine)
-  CPUCicles RTS(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles RTS();
   // SBC (SuBtract with Carry)
-  CPUCicles SBC(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles SBC();
   // STA (STore Accumulator)
-  CPUCicles STA(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles STA();
   // Stack Instructions
-  CPUCicles TXS(const opcodeParams &params);
-  CPUCicles TSX(const opcodeParams &params);
-  CPUCicles PHA(const opcodeParams &params);
-  CPUCicles PLA(const opcodeParams &params);
-  CPUCicles PHP(const opcodeParams &params);
-  CPUCicles PLP(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles TXS();
+  template <uint8_t OP> CPUCicles TSX();
+  template <uint8_t OP> CPUCicles PHA();
+  template <uint8_t OP> CPUCicles PLA();
+  template <uint8_t OP> CPUCicles PHP();
+  template <uint8_t OP> CPUCicles PLP();
   // STX (STore X register)
-  CPUCicles STX(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles STX();
   // STY (STore Y register)
-  CPUCicles STY(const opcodeParams &params);
+  template <uint8_t OP> CPUCicles STY();
+
+  // Opcodes não oficiais (semântica do NMOS 6502)
+  // - Leitura-modificação-escrita combinadas com uma operação no acumulador
+  template <uint8_t OP> CPUCicles SLO(); // ASL + ORA
+  template <uint8_t OP> CPUCicles RLA(); // ROL + AND
+  template <uint8_t OP> CPUCicles SRE(); // LSR + EOR
+  template <uint8_t OP> CPUCicles RRA(); // ROR + ADC
+  template <uint8_t OP> CPUCicles DCP(); // DEC + CMP
+  template <uint8_t OP> CPUCicles ISC(); // INC + SBC
+  // - Carga/armazenamento de A e X juntos
+  template <uint8_t OP> CPUCicles LAX();
+  template <uint8_t OP> CPUCicles SAX();
+  template <uint8_t OP> CPUCicles LAS();
+  // - Imediatos
+  template <uint8_t OP> CPUCicles ANC();
+  template <uint8_t OP> CPUCicles ALR();
+  template <uint8_t OP> CPUCicles ARR();
+  template <uint8_t OP> CPUCicles SBX();
+  // - Instáveis no hardware: usam as aproximações mais comuns (constante
+  //   0xEE em XAA/LXA; SHx/TAS gravam o valor AND (byte alto da base + 1))
+  template <uint8_t OP> CPUCicles XAA();
+  template <uint8_t OP> CPUCicles LXA();
+  template <uint8_t OP> CPUCicles SHA();
+  template <uint8_t OP> CPUCicles TAS();
+  template <uint8_t OP> CPUCicles SHY();
+  template <uint8_t OP> CPUCicles SHX();
+  // - KIL/JAM: trava a CPU até o reset (o PC não avança)
+  template <uint8_t OP> CPUCicles JAM();
+  // Soma com carry e overflow corretos (usada por RRA e ISC)
+  void addWithCarry(uint8_t value);
+  // Byte alto da base (endereço efetivo - índice) + 1, usado por SHx/TAS
+  uint8_t storeMask(uint16_t address, uint8_t index);
 
   void setAsmAddress(uint16_t address);
 
   uint64_t getCount();
+  uint64_t getCycles();
 
 private:
   // Memoria ram (2Kb)
@@ -219,7 +349,14 @@ private:
   uint8_t AC{};
   uint8_t X{};
   uint8_t Y{};
+  // Em SR ficam apenas I, D, B e _; N, Z, C e V são avaliados sob demanda
+  // (getSR/setSR) a partir do último resultado registrado pelas instruções
   uint8_t SR{0x30};
+  uint8_t nResult{};       // N = bit 7
+  uint8_t zResult{0x01};   // Z = (zResult == 0)
+  uint8_t carryFlag{};     // C (0 ou 1)
+  uint8_t overflowFlag{};  // V (0 ou 1)
+  void setSR(uint8_t value);
 
   // Flags
   void setFlag(Flag flag);
@@ -231,21 +368,111 @@ private:
   void stackPUSH(uint8_t value);
   uint8_t stackPOP();
 
-  using OpcodeHandler = CPUCicles (Cpu::*)(const opcodeParams &);
-  MemoryAccessResult getValueAddrMode(ADDR_MODE mode);
-  // Opcodes Mapping
-  // TODO: Usar std::function para OpcodeHandler aumentaria a perfeormance?
-  std::array<OpcodeHandler, 0xFF> opcodeMapping{};
-  std::array<opcodeParams, 0xFF> opcodeInfo{};
-  void fillOpcodeMapping();
+  // Modo de endereçamento resolvido em tempo de compilação
+  template <ADDR_MODE mode> MemoryAccessResult getValueAddrMode();
+  // Lê o valor do operando (imediato ou da memória)
+  template <ADDR_MODE mode> uint8_t readValue(const MemoryAccessResult &response);
+
+  // Bytes de operando da instrução atual (decodificados antes da execução)
+  uint16_t operand{};
+  template <bool FETCH, uint8_t OP> void fetchOperand();
+  // Executa o opcode (com FETCH, lendo antes os bytes de operando)
+  template <bool FETCH> CPUCicles execute(uint8_t opcode);
+
+  // Cache de blocos e posição da execução dentro do bloco atual
+  BlockCache blockCache;
+  bool blockCacheEnabled{false};
+  const MicroOp *blockCursor{nullptr};
+  const MicroOp *blockEnd{nullptr};
+  uint64_t blockGeneration{};
+  CPUCicles nextFromCache();
+
+  // Execuções de um bloco até ele ser compilado
+  static const uint32_t JIT_THRESHOLD = 16;
+  Jit jit;
+  bool jitEnabled{false};
+  BlockRun runBlock(Block &block);
+  // Pontos de entrada chamados pelo código gerado: um handler por opcode,
+  // com o operando já decodificado
+  using JitHandler = uint32_t (*)(Cpu *cpu, uint32_t operand);
+  template <uint8_t OP> static uint32_t jitHandler(Cpu *cpu, uint32_t operand);
+  template <int OP> struct JitTable;
+  struct JitHandlerTable;
+  static const JitHandler *jitHandlers();
+  // Registro de cada instrução do código gerado ("instruction" = opcode |
+  // operando << 8; ciclos do bloco antes dela)
+  static void jitTrace(Cpu *cpu, uint32_t instruction, uint32_t blockCycles);
 
   // Opcodes Array names
-  std::array<std::string, 0xFF> opcodesNames{opcodesList};
+  std::array<std::string, 0x100> opcodesNames{opcodesList};
 
   // Contador de operações (para debugar)
   uint64_t count{};
+  // Ciclos executados desde o último reset
+  uint64_t cycles{};
+  // Travada por um KIL/JAM
+  bool jammed{false};
+
+  // Laço ocioso: última análise e estado na última chegada ao início do
+  // laço (uma iteração completa entre duas chegadas)
+  bool idleSkipEnabled{true};
+  IdleLoop idleLoop;
+  CpuState idleState{};
+  uint64_t idleCycles{};
+  uint64_t idleCount{};
+  uint64_t skippedInstructions{};
+  uint64_t skippedCycles{};
+  // Chamado depois de um desvio para trás (PC <= PC anterior)
+  void skipIdleLoop(RunSummary &summary, uint64_t maxInstructions,
+                    uint64_t maxCycles);
+
+  // Interrupções de hardware
+  Scheduler scheduler;
+  bool nmiPending{false};
+  uint32_t irqLines{};
+  // Empilha PC e SR e salta para o vetor (retorna os ciclos gastos)
+  CPUCicles interrupt(uint16_t vector);
+  // Ciclo em que a execução deve parar para tratar eventos (com uma IRQ
+  // mascarada pendente, a cada instrução)
+  uint64_t eventDeadline() {
+    return (nmiPending || irqLines != 0) ? cycles : scheduler.nextEvent();
+  }
+  // Dispara os eventos vencidos e atende NMI/IRQ
+  void handleEvents(RunSummary &summary);
+  // Executa até o orçamento (sem eventos no meio)
+  void runSlice(RunSummary &summary, uint64_t maxInstructions,
+                uint64_t maxCycles);
+
+  Profiler profiler;
+
+  TraceBuffer trace;
+  // Registra o estado antes da instrução; o operando é preenchido depois da
+  // execução (nullptr com TRACE_ENABLED = false)
+  TraceRecord *traceInstruction(uint8_t opcode, uint64_t cycle);
 
-  void generateRandomIn0xFE();
+  RunSummary runBudget(uint64_t maxInstructions, uint64_t maxCycles);
+  template <typename Stop>
+  RunSummary runLoop(uint64_t maxInstructions, uint64_t maxCycles, Stop stop,
+                     StopReason reason) {
+    RunSummary summary{0, 0, StopReason::BUDGET};
+    while (summary.instructions < maxInstructions &&
+           summary.cycles < maxCycles) {
+      if (cycles >= eventDeadline()) {
+        handleEvents(summary);
+      }
+      if (jammed) {
+        summary.reason = StopReason::JAM;
+        break;
+      }
+      if (stop(*this)) {
+        summary.reason = reason;
+        break;
+      }
+      summary.cycles += next();
+      summary.instructions++;
+    }
+    return summary;
+  }
 };
 
 #endif
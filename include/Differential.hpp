@@ -0,0 +1,53 @@
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Cpu.hpp"
+#include "Mem.hpp"
+
+// Primeira diferença encontrada entre o Jit e o interpretador
+struct Divergence {
+  uint64_t block;        // Número do bloco executado
+  uint16_t blockStart;   // PC no início do bloco
+  CpuState jit;          // Registradores após o bloco (Jit)
+  CpuState reference;    // Registradores após o bloco (interpretador)
+  uint32_t jitCycles;
+  uint32_t referenceCycles;
+  int32_t address;       // Primeiro endereço de memória diferente (-1: nenhum)
+  uint8_t jitValue;
+  uint8_t referenceValue;
+};
+
+// Modo diferencial: executa o mesmo programa no Jit e no interpretador em
+// lockstep (bloco a bloco), comparando registradores, ciclos e memória
+// depois de cada bloco. As duas memórias usam a mesma semente, para que os
+// números aleatórios lidos em $FE coincidam.
+class DifferentialRunner {
+public:
+  DifferentialRunner(std::string path, uint16_t address, uint32_t seed);
+  ~DifferentialRunner();
+
+  // Executa até "blocks" blocos; retorna false ao encontrar uma divergência
+  bool run(uint64_t blocks);
+
+  const std::vector<Divergence> &getDivergences();
+  uint64_t getBlocks();
+  uint64_t getInstructions();
+  void report(std::ostream &out);
+
+private:
+  Memory jitMemory;
+  Memory referenceMemory;
+  Cpu jitCpu;
+  Cpu referenceCpu;
+
+  uint64_t blocks{};
+  uint64_t instructions{};
+  std::vector<Divergence> divergences;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef FARM_H
+#define FARM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Cpu.hpp"
+#include "Mem.hpp"
+
+// Uma execução independente: programa, semente de $FE e orçamento
+struct FarmJob {
+  // Compartilhado entre os jobs (não é copiado por job)
+  std::shared_ptr<const std::vector<uint8_t>> program;
+  uint16_t address{0x0600};
+  uint32_t seed{1};
+  uint64_t instructions{1000000};
+  // Orçamento de ciclos (0: apenas instruções)
+  uint64_t cycles{0};
+  bool jit{false};
+};
+
+// Estado final de um job
+struct FarmResult {
+  CpuState state;
+  RunSummary summary;
+  uint64_t memoryHash;
+};
+
+// Executa muitos programas curtos em paralelo (regressão, fuzzing).
+// Cada worker tem a sua própria instância Cpu/Memory, reaproveitada entre
+// os jobs. Os jobs são divididos em filas por worker; quem esvazia a
+// própria fila rouba do início da fila dos outros (work stealing).
+class Farm {
+public:
+  // Chamado no worker ao fim de cada job, antes da próxima execução na
+  // mesma instância (para coletar mais do que o FarmResult)
+  using Inspector = std::function<void(size_t job, Cpu &cpu, Memory &memory)>;
+
+  // workers = 0: um por núcleo
+  explicit Farm(size_t workers = 0);
+  ~Farm();
+
+  // Bloqueia até todos os jobs terminarem; resultados na ordem dos jobs
+  std::vector<FarmResult> run(const std::vector<FarmJob> &jobs,
+                              Inspector inspect = Inspector());
+
+  size_t getWorkers() const;
+  // Jobs executados por um worker diferente do dono da fila
+  uint64_t getSteals() const;
+
+private:
+  struct Worker;
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  // Lote atual (definido antes de liberar os workers)
+  const std::vector<FarmJob> *jobs{nullptr};
+  std::vector<FarmResult> *results{nullptr};
+  Inspector inspect;
+
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+  uint64_t batch{};
+  bool stopping{false};
+  std::atomic<size_t> pending{};
+  std::atomic<uint64_t> steals{};
+
+  void workerLoop(size_t index);
+  bool takeJob(size_t index, size_t &job);
+  static FarmResult runJob(Cpu &cpu, Memory &memory, const FarmJob &job);
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define GUI_H
 
 #include "Cpu.hpp"
+#include "Rewind.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Image.hpp>
@@ -56,6 +57,14 @@ private:
   sf::Text *zeroPageDataText;
   void updateZeroPageMemory();
 
+  // Endereços mais executados (apenas com -DBYTENES_PROFILER)
+  static const size_t PROFILER_TOP = 16;
+  sf::Text *profilerScreenTitle;
+  sf::RectangleShape *profilerScreen;
+  sf::Text *profilerDataText;
+  void updateProfiler();
+  void exportProfile();
+
   sf::Text *filePathText;
   sf::Text *keyMappingText;
 
@@ -64,9 +73,17 @@ private:
 
   Cpu &cpu;
 
+  // Histórico de estados (um por quadro); segurar a seta para a esquerda
+  // volta no tempo
+  RewindBuffer rewind;
+  void updateRewind(size_t frames);
+
+  // Regiões escritas desde o quadro anterior
+  size_t dirtyConsumer;
+
   std::array<sf::Color, 0xFF> colors{};
 
-  void loadFrameInMemory(uint16_t begin);
+  void loadFrameInMemory(uint16_t begin, const DirtyRegions &dirty);
 
   void updateCpuCount();
 
@@ -0,0 +1,33 @@
+#ifndef IDLELOOP_H
+#define IDLELOOP_H
+
+#include <cstdint>
+
+#include "Mem.hpp"
+
+// Registrador usado como contador de um laço de espera (DEX/DEY/INX/INY
+// seguido do BNE que fecha o laço)
+enum class IdleCounter { NONE, X, Y };
+
+// Análise estática de um laço curto iniciado em "head" e fechado por um
+// desvio (ou JMP) de volta para "head".
+// Um laço é ocioso ("idle loop") quando não escreve na memória, não usa a
+// pilha e só lê endereços sem efeitos colaterais (imediato, zeropage ou
+// absoluto, exceto $FE e páginas com dispositivos). Cada iteração então depende apenas dos
+// registradores e da memória, que o próprio laço não altera: a CPU pode
+// pular iterações inteiras (ver Cpu::skipIdleLoop).
+struct IdleLoop {
+  uint16_t head{};
+  bool valid{false}; // Análise feita para "head"
+  bool idle{false};
+  uint8_t length{}; // Instruções por iteração (incluindo o desvio)
+  IdleCounter counter{IdleCounter::NONE};
+  int8_t step{}; // -1 (DEX/DEY) ou +1 (INX/INY)
+};
+
+// Maior laço analisado (em instruções)
+const uint8_t IDLE_LOOP_MAX_LENGTH = 8;
+
+IdleLoop analyzeIdleLoop(const Memory &memory, uint16_t head);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef INTERVALTIMER_H
+#define INTERVALTIMER_H
+
+#include <cstdint>
+
+#include "Cpu.hpp"
+#include "Scheduler.hpp"
+
+// Timer periódico: gera uma NMI a cada "period" ciclos da CPU (por exemplo,
+// o vblank de um quadro). Exemplo de dispositivo registrado no Scheduler.
+class IntervalTimer : public ScheduledDevice {
+public:
+  IntervalTimer(Cpu &cpu, uint64_t period);
+  ~IntervalTimer();
+
+  // Primeiro disparo "period" ciclos depois do ciclo atual da CPU
+  void start();
+  void stop();
+
+  uint64_t getTicks() const;
+
+  void onEvent(uint64_t cycle, uint32_t tag, Scheduler &scheduler) override;
+
+private:
+  Cpu &cpu;
+  uint64_t period;
+  uint64_t ticks{};
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BlockCache.hpp"
+
+class Cpu;
+
+// Recompilador dinâmico (x86-64) dos blocos do cache.
+// O código gerado é "call-threaded": cada instrução vira uma chamada direta
+// ao handler do interpretador especializado para o opcode (mesma semântica de
+// Cpu::ADC…Cpu::STY), sem o despacho pelo switch. Instruções que não acessam a memória
+// (transferências, INX/DEX/INY/DEY, flags, NOP, LDx/CPx imediatos e desvios
+// condicionais) são emitidas diretamente em código nativo.
+// Em plataformas sem suporte, compile() retorna nullptr e o bloco continua
+// sendo interpretado.
+class Jit {
+public:
+  Jit(Cpu &cpu);
+  ~Jit();
+
+  static bool isSupported();
+
+  // Gera o código nativo do bloco (nullptr se não for possível)
+  JitCode compile(const Block &block);
+
+  // Incrementado quando a área de código é reciclada; código compilado em
+  // uma época anterior não pode mais ser executado
+  uint32_t getEpoch() const { return epoch; }
+
+  uint64_t getCompiledBlocks() const;
+  size_t getCodeSize() const;
+
+private:
+  // Área de código executável (reciclada inteira quando cheia)
+  static const size_t CODE_CAPACITY = 4 << 20;
+
+  Cpu &cpu;
+  uint8_t *code{nullptr};
+  size_t used{};
+  uint32_t epoch{1};
+  uint64_t compiledBlocks{};
+};
+
+#endif
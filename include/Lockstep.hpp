@@ -0,0 +1,106 @@
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Cpu.hpp"
+#include "Mem.hpp"
+
+// Quantidade máxima de instâncias (pistas) executadas juntas: 16 registradores
+// de 8 bits ocupam um registrador SIMD de 128 bits
+const size_t LOCKSTEP_LANES = 16;
+
+// Uso das pistas durante a execução
+struct LockstepStats {
+  uint64_t steps;              // Passos (uma instrução por pista ativa)
+  uint64_t vectorIssues;       // Instruções executadas em lote
+  uint64_t vectorLanes;        // Pistas atendidas por essas instruções
+  uint64_t scalarInstructions; // Instruções executadas pelo Cpu da pista
+  uint64_t divergentSteps;     // Passos com pistas em PCs diferentes
+
+  // Fração das pistas ocupadas nas instruções em lote
+  double utilization(size_t lanes) const {
+    return vectorIssues > 0
+               ? static_cast<double>(vectorLanes) / (vectorIssues * lanes)
+               : 0;
+  }
+  // Fração das instruções executadas em lote
+  double vectorFraction() const {
+    uint64_t total = vectorLanes + scalarInstructions;
+    return total > 0 ? static_cast<double>(vectorLanes) / total : 0;
+  }
+};
+
+// Executa várias instâncias do mesmo programa (entradas/sementes diferentes)
+// em lockstep, com os registradores e flags em structure-of-arrays. A cada
+// passo, as pistas com o mesmo PC (e os mesmos bytes de instrução) formam um
+// grupo; instruções simples (cargas, armazenamentos, ALU, transferências,
+// desvios) são executadas para o grupo inteiro com operações por pista sem
+// desvios (vetorizadas pelo compilador). As demais instruções, e as pistas
+// que divergiram sozinhas, usam o interpretador do Cpu da própria pista.
+// Eventos do Scheduler e interrupções não são atendidos.
+class Lockstep {
+public:
+  // lanes: 1 a LOCKSTEP_LANES
+  explicit Lockstep(size_t lanes);
+  ~Lockstep();
+
+  // Carrega o programa em todas as pistas (uma semente de $FE por pista) e
+  // reseta as CPUs
+  void load(const std::vector<uint8_t> &program, uint16_t address,
+            const std::vector<uint32_t> &seeds);
+
+  // Executa até "steps" passos; para antes se todas as pistas travarem
+  // (JAM). Retorna a quantidade de passos executados.
+  uint64_t run(uint64_t steps);
+
+  size_t getLanes() const;
+  CpuState getState(size_t lane) const;
+  uint64_t getCycles(size_t lane) const;
+  uint64_t getInstructions(size_t lane) const;
+  bool isJammed(size_t lane) const;
+  Memory &getMemory(size_t lane);
+  const LockstepStats &getStats() const;
+
+private:
+  // Registradores e flags (flags N/Z/C/V no formato preguiçoso do Cpu)
+  struct Registers {
+    alignas(32) uint8_t AC[LOCKSTEP_LANES];
+    alignas(32) uint8_t X[LOCKSTEP_LANES];
+    alignas(32) uint8_t Y[LOCKSTEP_LANES];
+    alignas(32) uint8_t SP[LOCKSTEP_LANES];
+    alignas(32) uint8_t SR[LOCKSTEP_LANES]; // Bits sem N, Z, C e V
+    alignas(32) uint8_t nResult[LOCKSTEP_LANES];
+    alignas(32) uint8_t zResult[LOCKSTEP_LANES];
+    alignas(32) uint8_t carry[LOCKSTEP_LANES];
+    alignas(32) uint8_t overflow[LOCKSTEP_LANES];
+    alignas(32) uint16_t PC[LOCKSTEP_LANES];
+  };
+
+  size_t lanes;
+  Registers regs{};
+  std::vector<std::unique_ptr<Memory>> memories;
+  std::vector<std::unique_ptr<Cpu>> cpus;
+  // Pista cujo estado está no Cpu (após uma instrução escalar); o PC fica
+  // sempre atualizado em regs
+  bool inCpu[LOCKSTEP_LANES]{};
+  bool jammed[LOCKSTEP_LANES]{};
+  uint64_t cycles[LOCKSTEP_LANES]{};
+  uint64_t instructions[LOCKSTEP_LANES]{};
+  LockstepStats stats{};
+
+  CpuState laneState(size_t lane) const;
+  void pullFromCpu(size_t lane);
+  void pushToCpu(size_t lane);
+
+  // Instrução em "pc" de uma pista (opcode e operando)
+  uint32_t fetch(size_t lane, uint16_t pc) const;
+  void runScalar(size_t lane);
+  // mask: 0xFF nas pistas do grupo
+  bool runVector(uint8_t opcode, uint16_t operand, const uint8_t *mask);
+};
+
+#endif
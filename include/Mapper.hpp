@@ -0,0 +1,149 @@
+#ifndef MAPPER_H
+#define MAPPER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Cartridge.hpp"
+#include "Mem.hpp"
+
+// Mapper do cartucho: mapeia os bancos de PRG ROM em $8000–$FFFF
+// reapontando as páginas da Memory (sem cópia) e recebe as escritas nessa
+// faixa como registradores. Os bancos de CHR ficam em 8 janelas de 1 KiB
+// ($0000–$1FFF da PPU). $6000–$7FFF continua sendo a RAM da Memory (PRG
+// RAM sempre habilitada). Memory::reset volta o mapper ao estado inicial.
+// Enquanto o mapper existe, $FE é RAM comum (sem números aleatórios).
+class Mapper : public PageHandler, public ResetWatcher {
+public:
+  // Sem registradores as páginas de ROM ficam sem handler e a Memory
+  // descarta as escritas sem chamar o mapper
+  Mapper(Cartridge &cartridge, Memory &memory, bool registers = true);
+  // Devolve $8000–$FFFF ao armazenamento da Memory
+  ~Mapper() override;
+  Mapper(const Mapper &) = delete;
+  Mapper &operator=(const Mapper &) = delete;
+
+  // As páginas de ROM são lidas direto pela tabela: só leituras de páginas
+  // com dispositivos chegam aqui (barramento aberto)
+  uint8_t read(uint16_t address) override { return peek(address); }
+  uint8_t peek(uint16_t) const override { return 0; }
+  // Registradores: cada mapper (final) implementa write, chamado pelo
+  // PageHandler da página (uma chamada virtual por escrita em $8000–$FFFF,
+  // sem especialização do barramento em tempo de compilação)
+
+  // Memória de padrões vista pela PPU
+  uint8_t readChr(uint16_t address) const;
+  // Só altera CHR RAM
+  void writeChr(uint16_t address, uint8_t value);
+  const uint8_t *getChrBank(uint8_t window) const;
+  Mirroring getMirroring() const { return mirroring; }
+
+  // Fim de scanline (a PPU chama; usado pelo contador do MMC3). Quem executa
+  // a CPU repassa isIRQActive() para Cpu::setIRQ
+  virtual void onScanline() {}
+  bool isIRQActive() const { return irq; }
+
+  // Trocas de banco que reapontaram alguma página
+  uint64_t getBankSwitches() const { return bankSwitches; }
+
+  // Registradores, bancos e espelhamento iniciais e o trainer de novo em
+  // $7000 (a Memory acabou de ser zerada)
+  void onReset() override;
+  // Trainer (se houver) em $7000
+  void loadTrainer();
+
+protected:
+  Cartridge &cartridge;
+  Memory &memory;
+  Mirroring mirroring;
+  bool irq{false};
+
+  // Mapeia em "address" o banco "bank" de "size" bytes (negativo conta a
+  // partir do último); bancos maiores que a ROM se repetem
+  void mapPrg(uint16_t address, size_t size, int bank);
+  void mapChr(uint16_t address, size_t size, int bank);
+  // Registradores e bancos de quando o console é ligado (os construtores
+  // também a chamam)
+  virtual void powerOn() = 0;
+
+private:
+  // Deslocamento de cada janela de 1 KiB na CHR
+  std::array<size_t, 8> chrBanks{};
+  std::array<const uint8_t *, 0x80> prgPages{};
+  PageHandler *handler;
+  uint64_t bankSwitches{};
+};
+
+// Mapper 0: 16 ou 32 KiB de PRG e 8 KiB de CHR fixos
+class NromMapper final : public Mapper {
+public:
+  NromMapper(Cartridge &cartridge, Memory &memory);
+  // Não é chamado (páginas sem handler)
+  void write(uint16_t, uint8_t) override {}
+
+private:
+  void powerOn() override;
+};
+
+// Mapper 1 (MMC1): registrador serial de 5 bits; PRG em 16/32 KiB, CHR em
+// 4/8 KiB e espelhamento programável
+class Mmc1Mapper final : public Mapper {
+public:
+  Mmc1Mapper(Cartridge &cartridge, Memory &memory);
+  void write(uint16_t address, uint8_t value) override;
+
+private:
+  uint8_t shift;
+  uint8_t control;
+  uint8_t chr0;
+  uint8_t chr1;
+  uint8_t prg;
+  void powerOn() override;
+  void updateBanks();
+};
+
+// Mapper 2 (UxROM): 16 KiB trocáveis em $8000 e o último banco em $C000
+class UxromMapper final : public Mapper {
+public:
+  UxromMapper(Cartridge &cartridge, Memory &memory);
+  void write(uint16_t address, uint8_t value) override;
+
+private:
+  void powerOn() override;
+};
+
+// Mapper 3 (CNROM): PRG fixa e 8 KiB de CHR trocáveis
+class CnromMapper final : public Mapper {
+public:
+  CnromMapper(Cartridge &cartridge, Memory &memory);
+  void write(uint16_t address, uint8_t value) override;
+
+private:
+  void powerOn() override;
+};
+
+// Mapper 4 (MMC3): PRG em 8 KiB, CHR em 1/2 KiB e IRQ por scanline
+class Mmc3Mapper final : public Mapper {
+public:
+  Mmc3Mapper(Cartridge &cartridge, Memory &memory);
+  void onScanline() override;
+  void write(uint16_t address, uint8_t value) override;
+
+private:
+  uint8_t bankSelect;
+  std::array<uint8_t, 8> registers;
+  uint8_t irqLatch;
+  uint8_t irqCounter;
+  bool irqReload;
+  bool irqEnabled;
+  void powerOn() override;
+  void updateBanks();
+};
+
+// Mapper do cabeçalho já ligado à Memory (e o trainer carregado em $7000);
+// nullptr se o número do mapper não for suportado
+std::unique_ptr<Mapper> createMapper(Cartridge &cartridge, Memory &memory);
+
+#endif
@@ -3,37 +3,329 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #define MEMSIZE 0xFFFF + 0x0001
 
+// Específico do emulador do endereço
+// https://skilldrick.github.io/easy6502/
+// Cada leitura de dados em $FE devolve um número aleatório (1 a 255); a busca
+// de instruções (peek) não gera números.
+// IMPORTANTE: Não é comportamente nativo do 6502.
+const uint16_t RANDOM_ADDRESS = 0x00FE;
+
+class MemoryDump;
+class RomImage;
+
+// Interface notificada quando uma página observada é escrita
+// (usada, por exemplo, pelo cache de blocos para detectar código
+// automodificável)
+class PageWatcher {
+public:
+  virtual ~PageWatcher() {}
+  virtual void onPageWrite(uint8_t page) = 0;
+};
+
+// Avisado por Memory::reset depois que a memória é recarregada (o mapper do
+// cartucho volta ao estado inicial)
+class ResetWatcher {
+public:
+  virtual ~ResetWatcher() {}
+  virtual void onReset() = 0;
+};
+
+// Leituras/escritas de uma página sem ponteiro direto na tabela de páginas
+// (registradores com efeitos colaterais)
+class PageHandler {
+public:
+  virtual ~PageHandler() {}
+  virtual uint8_t read(uint16_t address) = 0;
+  // Leitura sem efeitos colaterais
+  virtual uint8_t peek(uint16_t address) const = 0;
+  virtual void write(uint16_t address, uint8_t value) = 0;
+};
+
+// Registradores $2000–$2007 espelhados a cada 8 bytes até $3FFF. A página
+// guarda a visão espelhada (lida diretamente pela tabela de páginas); a
+// escrita atualiza as 32 cópias do registrador na página.
+class RegisterMirror : public PageHandler {
+public:
+  explicit RegisterMirror(uint8_t *page) : page(page) {}
+  uint8_t read(uint16_t address) override { return page[address & 0xFF]; }
+  uint8_t peek(uint16_t address) const override {
+    return page[address & 0xFF];
+  }
+  void write(uint16_t address, uint8_t value) override;
+
+private:
+  uint8_t *page;
+};
+
+// Faixa de endereços (inclusiva) atendida por um dispositivo
+struct MmioRange {
+  uint16_t begin;
+  uint16_t end;
+  PageHandler *device;
+};
+
+// Linhas de 64 bytes alteradas no espaço de endereços (4 por página; uma
+// escrita marca também os espelhos da linha)
+struct DirtyRegions {
+  static const size_t LINE_SIZE = 64;
+  std::array<uint64_t, 0x10000 / LINE_SIZE / 64> lines{};
+
+  bool isLineDirty(uint16_t address) const {
+    const size_t line = address / LINE_SIZE;
+    return (lines[line >> 6] >> (line & 63)) & 1;
+  }
+  bool isPageDirty(uint8_t page) const {
+    return ((lines[page >> 4] >> ((page & 0x0F) << 2)) & 0x0F) != 0;
+  }
+  // Alguma linha de [begin, end] alterada
+  bool isRangeDirty(uint16_t begin, uint16_t end) const {
+    for (size_t line = begin / LINE_SIZE; line <= end / LINE_SIZE; line++) {
+      if ((lines[line >> 6] >> (line & 63)) & 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Barramento com tabela de 256 páginas: cada página aponta para os seus 256
+// bytes (leitura/escrita em uma consulta e um acesso) ou, sem ponteiro, usa
+// o PageHandler da página. Espelhos são ponteiros para o mesmo
+// armazenamento (as páginas $08–$1F apontam para os 2 KiB de RAM).
 class Memory {
 public:
   Memory();
   ~Memory();
+  // A tabela aponta para o próprio armazenamento
+  Memory(const Memory &) = delete;
+  Memory &operator=(const Memory &) = delete;
+
+  // Leitura feita pelo programa ($FE e os espelhos geram um novo número
+  // aleatório)
+  uint8_t read(uint16_t address) {
+    if (isRandomAddress(address)) {
+      return nextRandom();
+    }
+    const uint8_t *bytes = readPages[address >> 8];
+    return bytes != nullptr ? bytes[address & 0xFF]
+                            : handlers[address >> 8]->read(address);
+  }
+  // Leitura sem efeitos colaterais (interface, depuração, decodificação)
+  uint8_t peek(uint16_t address) const {
+    const uint8_t *bytes = readPages[address >> 8];
+    return bytes != nullptr ? bytes[address & 0xFF]
+                            : handlers[address >> 8]->peek(address);
+  }
+  void write(uint16_t address, uint8_t value) {
+    const uint8_t page = address >> 8;
+    uint8_t *bytes = writePages[page];
+    if (bytes != nullptr) {
+      bytes[address & 0xFF] = value;
+      markDirty(page, address);
+    } else {
+      if (handlers[page] != nullptr) {
+        handlers[page]->write(address, value);
+      }
+      // A ROM não muda com a escrita: a troca de banco já é marcada e
+      // avisada por mapRomPage
+      if (romPages[page]) {
+        return;
+      }
+      // O handler pode alterar outras linhas (o RegisterMirror grava as 32
+      // cópias do registrador)
+      markPageDirty(page);
+    }
+    if (watchedCount > 0) {
+      notifyWrite(page);
+    }
+  }
 
-  uint8_t read(uint16_t address);
-  void write(uint16_t address, uint8_t value);
+  // Semente do gerador de $FE: a mesma semente reproduz a execução
+  void setRandomSeed(uint32_t seed);
+  // Números aleatórios em $FE (convenção dos binários do easy6502). O
+  // mapper desliga enquanto um cartucho está ligado: nos jogos $FE é RAM
+  void enableRandomSource(bool enable);
+  // Leitura que gera um número: $FE ou um dos seus espelhos na RAM ($08FE,
+  // $10FE e $18FE), com a fonte ligada
+  bool isRandomAddress(uint16_t address) const {
+    return randomSource && (address & 0xE7FF) == RANDOM_ADDRESS;
+  }
 
   void fillRandomData();
   void fillSequencialData();
   void fillZeroData();
 
+  // Escrita de um bloco (espelhos e marcações como em write): páginas com
+  // ponteiro direto são copiadas de uma vez
+  void writeBlock(uint16_t address, const uint8_t *bytes, size_t size);
+
+  // Mapeia o arquivo (mantido para reset(), que não volta a lê-lo) e o
+  // copia a partir de addrBase
   void loadMemoryFromFile(std::string path, uint16_t addrBase = 0x00);
-  void enableSaveStatusToFile(bool enable);
+  // Carrega um programa já em memória (reset() volta a carregá-lo)
+  void loadProgram(const std::vector<uint8_t> &program,
+                   uint16_t addrBase = 0x00);
+  // Imagem do espaço de endereços em memory_status/memory.bin, mapeada em
+  // memória: o armazenamento passa a ser o próprio arquivo (as escritas o
+  // atualizam sem custo extra) e uma thread o grava no disco a cada
+  // "intervalMs" milissegundos
+  void enableSaveStatusToFile(bool enable, unsigned intervalMs = 100);
+  // Copia para o arquivo os espelhos e as páginas fora do armazenamento
+  // (uma vez por quadro, por exemplo): só as linhas alteradas desde a
+  // cópia anterior, e as páginas de ROM após uma troca de banco
   void saveMemoryStatusToFile();
   std::string getFilePath();
+  // Zera a memória, recarrega o programa e avisa o ResetWatcher
   void reset();
+  void setResetWatcher(ResetWatcher *watcher);
+
+  // Dispositivo mapeado em [begin, end] (PPU em $2000–$3FFF, APU e
+  // controles em $4000–$401F etc.), que recebe o endereço sem espelhamento.
+  // As páginas da faixa perdem o ponteiro direto e passam pelo registro;
+  // endereços dessas páginas fora das faixas usam o mapeamento anterior e as
+  // demais páginas não pagam nada a mais. Faixas registradas depois têm
+  // prioridade. O estado do dispositivo não faz parte de getPage/restorePage.
+  void attachDevice(uint16_t begin, uint16_t end, PageHandler *device);
+  void detachDevice(PageHandler *device);
+  // Página com dispositivo (a leitura pode ter efeitos colaterais)
+  bool isDevicePage(uint8_t page) const { return readPages[page] == nullptr; }
+
+  // Página de ROM do cartucho: leitura direta do banco (sem cópia) e
+  // escrita pelo handler (registradores do mapper). Trocar o banco só
+  // reaponta a página, que é marcada como alterada e avisada aos
+  // observadores. Sem handler (mapper sem registradores, como o NROM) a
+  // escrita é descartada ali mesmo. Escritas em páginas de ROM não marcam
+  // linhas nem avisam os observadores. Páginas de ROM não têm espelhos e
+  // restorePage as ignora (os bancos são estado do mapper).
+  void mapRomPage(uint8_t page, const uint8_t *bytes, PageHandler *handler);
+  // Volta a página ao próprio armazenamento
+  void unmapRomPage(uint8_t page);
+  bool isRomPage(uint8_t page) const { return romPages[page]; }
+
+  // Observação de escritas por página (256 bytes)
+  void setPageWatcher(PageWatcher *watcher);
+  void watchPage(uint8_t page);
+  void unwatchPage(uint8_t page);
+
+  // Regiões alteradas para vários consumidores (interface, save states,
+  // rewind): cada consumidor recebe as linhas escritas desde a sua última
+  // consulta, e a primeira consulta devolve tudo
+  size_t addDirtyConsumer();
+  void removeDirtyConsumer(size_t consumer);
+  DirtyRegions consumeDirty(size_t consumer);
+  // Conteúdo da página como visto pelo programa (espelhos compartilham o
+  // mesmo armazenamento)
+  const uint8_t *getPage(uint8_t page) const;
+  // Sobrescreve uma página inteira (e os seus espelhos; páginas de ROM são
+  // ignoradas)
+  void restorePage(uint8_t page, const uint8_t *bytes);
+  // Estado atual do gerador de $FE (setRandomSeed o restaura)
+  uint32_t getRandomState() const;
+
+  // Primeiro endereço em que as duas memórias diferem (-1 se iguais)
+  int32_t firstDifference(const Memory &other) const;
+  // Hash do conteúdo (FNV-1a sobre palavras de 64 bits)
+  uint64_t hash() const;
 
 private:
-  // Habilita o salvamento do status da memória do emulador em um
-  // arquivo externo (memory_status.bi). Habilitar apenas para debugar
-  // pois as operaçṍes de IO causa overhead e lentidão na execução dos 
-  // opcodes
-  bool saveStatusToFile;
-  std::array<uint8_t, MEMSIZE> data;
+  // Armazenamento: RAM em $0000–$07FF, registradores espelhados em
+  // $2000–$20FF e as demais páginas sem espelhamento na própria posição.
+  // Fica em ownData ou, com o arquivo de status, na imagem mapeada
+  std::array<uint8_t, MEMSIZE> ownData;
+  uint8_t *data{ownData.data()};
+  RegisterMirror registers{data + 0x2000};
+  std::unique_ptr<MemoryDump> statusDump;
+  // Consumidor das regiões alteradas usado pelo arquivo de status
+  size_t statusConsumer{};
+  // Move o armazenamento e reaponta a tabela de páginas
+  void relocate(uint8_t *storage);
+
+  // Tabela de páginas (nullptr: acesso pelo handler da página)
+  std::array<uint8_t *, 0x100> readPages;
+  std::array<uint8_t *, 0x100> writePages;
+  std::array<PageHandler *, 0x100> handlers;
+  // Armazenamento de cada página (getPage/restorePage)
+  std::array<uint8_t *, 0x100> pageStorage;
+  // Primeira página com o mesmo armazenamento (as marcações de escrita
+  // ficam nela) e próxima página do anel de espelhos
+  std::array<uint8_t, 0x100> canonicalPages;
+  std::array<uint8_t, 0x100> nextAlias;
+  std::array<bool, 0x100> romPages{};
+  void mapPage(uint8_t page, uint8_t *storage, bool writable,
+               PageHandler *handler);
+  void linkAliases();
+
+  // Handler das páginas com dispositivos
+  class DeviceDispatch : public PageHandler {
+  public:
+    explicit DeviceDispatch(Memory &memory) : memory(memory) {}
+    uint8_t read(uint16_t address) override;
+    uint8_t peek(uint16_t address) const override;
+    void write(uint16_t address, uint8_t value) override;
+
+  private:
+    Memory &memory;
+  };
+  DeviceDispatch deviceDispatch{*this};
+  std::vector<MmioRange> devices;
+  // Mapeamento das páginas antes do primeiro dispositivo
+  std::array<uint8_t *, 0x100> fallbackRead{};
+  std::array<uint8_t *, 0x100> fallbackWrite{};
+  std::array<PageHandler *, 0x100> fallbackHandlers{};
+  const MmioRange *findDevice(uint16_t address) const;
   std::string filePath;
+  std::unique_ptr<RomImage> rom;
+  // Programa carregado por loadProgram (sem arquivo)
+  std::vector<uint8_t> program;
   uint16_t asmAddress;
+
+  // Estado do xorshift32 (nunca zero)
+  uint32_t randomState;
+  bool randomSource{true};
+  uint8_t nextRandom();
+
+  ResetWatcher *resetWatcher{nullptr};
+  PageWatcher *pageWatcher{nullptr};
+  std::array<bool, 0x100> watchedPages{};
+  size_t watchedCount{};
+  // Notifica a página e os seus espelhos
+  void notifyWrite(uint8_t page) {
+    uint8_t alias = page;
+    do {
+      if (watchedPages[alias]) {
+        pageWatcher->onPageWrite(alias);
+      }
+      alias = nextAlias[alias];
+    } while (alias != page);
+  }
+  void notifyAllPages();
+
+  // Linhas escritas ainda não repassadas aos consumidores, indexadas pelo
+  // armazenamento (linhas da página canônica): marcar é um OR
+  using DirtyLines =
+      std::array<uint64_t, 0x10000 / DirtyRegions::LINE_SIZE / 64>;
+  DirtyLines dirtyLines{};
+  struct DirtyConsumer {
+    bool active;
+    DirtyLines lines;
+  };
+  std::vector<DirtyConsumer> dirtyConsumers;
+  void markDirty(uint8_t page, uint16_t address) {
+    const size_t line = (static_cast<size_t>(canonicalPages[page]) << 2) |
+                        ((address & 0xFF) / DirtyRegions::LINE_SIZE);
+    dirtyLines[line >> 6] |= static_cast<uint64_t>(1) << (line & 63);
+  }
+  void markPageDirty(uint8_t page) {
+    const uint8_t canonical = canonicalPages[page];
+    dirtyLines[canonical >> 4] |= static_cast<uint64_t>(0x0F)
+                                  << ((canonical & 0x0F) << 2);
+  }
 };
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef MEMORY_DUMP_H
+#define MEMORY_DUMP_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Arquivo de "size" bytes mapeado em memória (MAP_SHARED): quem escreve na
+// imagem atualiza o arquivo no próprio lugar, e visualizadores externos o
+// leem pelo cache de páginas do sistema. Uma thread grava a imagem no disco
+// (msync) a cada "interval", fora da thread da emulação.
+class MemoryDump {
+public:
+  MemoryDump(const std::string &path, size_t size,
+             std::chrono::milliseconds interval);
+  // Para a thread, grava e desmapeia a imagem
+  ~MemoryDump();
+  MemoryDump(const MemoryDump &) = delete;
+  MemoryDump &operator=(const MemoryDump &) = delete;
+
+  // false se o arquivo não pôde ser criado/mapeado (sem thread)
+  bool isOpen() const { return image != nullptr; }
+  uint8_t *getImage() { return image; }
+  // Gravação síncrona (fora do intervalo)
+  void flush();
+  uint64_t getFlushes() const;
+
+private:
+  int fd{-1};
+  uint8_t *image{nullptr};
+  size_t size;
+  std::chrono::milliseconds interval;
+
+  std::thread thread;
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  bool stopping{false};
+  uint64_t flushes{};
+  void flushLoop();
+};
+
+#endif
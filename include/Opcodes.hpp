@@ -0,0 +1,310 @@
+#ifndef OPCODES_H
+#define OPCODES_H
+
+#include <cstdint>
+
+enum class ADDR_MODE {
+  IMMEDIATE,
+  ZEROPAGE,
+  ZEROPAGE_X,
+  ZEROPAGE_Y,
+  ABSOLUTE,
+  ABSOLUTE_X,
+  ABSOLUTE_Y,
+  INDIRECT,
+  INDIRECT_X,
+  INDIRECT_Y,
+  RELATIVE,
+  NONE
+};
+
+struct opcodeParams {
+  ADDR_MODE addrMode;
+  uint8_t cycles;
+  uint8_t cyclesOnPageCross;
+};
+
+// Parâmetros de cada opcode (modo de endereçamento, ciclos e ciclos extras
+// quando há "page boundary crossed"). A tabela é constexpr para que cada
+// instância dos handlers receba esses valores em tempo de compilação.
+// Inclui os opcodes não oficiais (marcados com "*"); os KIL/JAM travam a CPU.
+constexpr opcodeParams opcodeInfo[0x100] = {
+    {ADDR_MODE::NONE, 7, 0}, // 0x00 BRK impl
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x01 ORA X,ind
+    {ADDR_MODE::NONE, 2, 0}, // 0x02 *JAM impl
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0x03 *SLO X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x04 *NOP zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x05 ORA zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x06 ASL zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x07 *SLO zpg
+    {ADDR_MODE::NONE, 3, 0}, // 0x08 PHP impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x09 ORA #
+    {ADDR_MODE::NONE, 2, 0}, // 0x0A ASL A
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x0B *ANC #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x0C *NOP abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x0D ORA abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x0E ASL abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x0F *SLO abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0x10 BPL rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0x11 ORA ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x12 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0x13 *SLO ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x14 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x15 ORA zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x16 ASL zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x17 *SLO zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0x18 CLC impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0x19 ORA abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x1A *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0x1B *SLO abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x1C *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x1D ORA abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x1E ASL abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x1F *SLO abs,X
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x20 JSR abs
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x21 AND X,ind
+    {ADDR_MODE::NONE, 2, 0}, // 0x22 *JAM impl
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0x23 *RLA X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x24 BIT zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x25 AND zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x26 ROL zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x27 *RLA zpg
+    {ADDR_MODE::NONE, 4, 0}, // 0x28 PLP impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x29 AND #
+    {ADDR_MODE::NONE, 2, 0}, // 0x2A ROL A
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x2B *ANC #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x2C BIT abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x2D AND abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x2E ROL abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x2F *RLA abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0x30 BMI rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0x31 AND ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x32 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0x33 *RLA ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x34 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x35 AND zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x36 ROL zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x37 *RLA zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0x38 SEC impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0x39 AND abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x3A *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0x3B *RLA abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x3C *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x3D AND abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x3E ROL abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x3F *RLA abs,X
+    {ADDR_MODE::NONE, 6, 0}, // 0x40 RTI impl
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x41 EOR X,ind
+    {ADDR_MODE::NONE, 2, 0}, // 0x42 *JAM impl
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0x43 *SRE X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x44 *NOP zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x45 EOR zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x46 LSR zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x47 *SRE zpg
+    {ADDR_MODE::NONE, 3, 0}, // 0x48 PHA impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x49 EOR #
+    {ADDR_MODE::NONE, 2, 0}, // 0x4A LSR A
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x4B *ALR #
+    {ADDR_MODE::ABSOLUTE, 3, 0}, // 0x4C JMP abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x4D EOR abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x4E LSR abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x4F *SRE abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0x50 BVC rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0x51 EOR ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x52 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0x53 *SRE ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x54 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x55 EOR zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x56 LSR zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x57 *SRE zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0x58 CLI impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0x59 EOR abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x5A *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0x5B *SRE abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x5C *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x5D EOR abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x5E LSR abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x5F *SRE abs,X
+    {ADDR_MODE::NONE, 6, 0}, // 0x60 RTS impl
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x61 ADC X,ind
+    {ADDR_MODE::NONE, 2, 0}, // 0x62 *JAM impl
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0x63 *RRA X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x64 *NOP zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x65 ADC zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x66 ROR zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0x67 *RRA zpg
+    {ADDR_MODE::NONE, 4, 0}, // 0x68 PLA impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x69 ADC #
+    {ADDR_MODE::NONE, 2, 0}, // 0x6A ROR A
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x6B *ARR #
+    {ADDR_MODE::INDIRECT, 5, 0}, // 0x6C JMP ind
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x6D ADC abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x6E ROR abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0x6F *RRA abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0x70 BVS rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0x71 ADC ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x72 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0x73 *RRA ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x74 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x75 ADC zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x76 ROR zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0x77 *RRA zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0x78 SEI impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0x79 ADC abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x7A *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0x7B *RRA abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x7C *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0x7D ADC abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x7E ROR abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0x7F *RRA abs,X
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x80 *NOP #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x81 STA X,ind
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x82 *NOP #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0x83 *SAX X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x84 STY zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x85 STA zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x86 STX zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0x87 *SAX zpg
+    {ADDR_MODE::NONE, 2, 0}, // 0x88 DEY impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x89 *NOP #
+    {ADDR_MODE::NONE, 2, 0}, // 0x8A TXA impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0x8B *XAA #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x8C STY abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x8D STA abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x8E STX abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0x8F *SAX abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0x90 BCC rel
+    {ADDR_MODE::INDIRECT_Y, 6, 0}, // 0x91 STA ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x92 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 6, 0}, // 0x93 *SHA ind,Y
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0x94 STY zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0x95 STA zpg,X
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0x96 STX zpg,Y
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0x97 *SAX zpg,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x98 TYA impl
+    {ADDR_MODE::ABSOLUTE_Y, 5, 0}, // 0x99 STA abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0x9A TXS impl
+    {ADDR_MODE::ABSOLUTE_Y, 5, 0}, // 0x9B *TAS abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 5, 0}, // 0x9C *SHY abs,X
+    {ADDR_MODE::ABSOLUTE_X, 5, 0}, // 0x9D STA abs,X
+    {ADDR_MODE::ABSOLUTE_Y, 5, 0}, // 0x9E *SHX abs,Y
+    {ADDR_MODE::ABSOLUTE_Y, 5, 0}, // 0x9F *SHA abs,Y
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xA0 LDY #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0xA1 LDA X,ind
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xA2 LDX #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0xA3 *LAX X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xA4 LDY zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xA5 LDA zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xA6 LDX zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xA7 *LAX zpg
+    {ADDR_MODE::NONE, 2, 0}, // 0xA8 TAY impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xA9 LDA #
+    {ADDR_MODE::NONE, 2, 0}, // 0xAA TAX impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xAB *LXA #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xAC LDY abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xAD LDA abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xAE LDX abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xAF *LAX abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0xB0 BCS rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0xB1 LDA ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xB2 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0xB3 *LAX ind,Y
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0xB4 LDY zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0xB5 LDA zpg,X
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0xB6 LDX zpg,Y
+    {ADDR_MODE::ZEROPAGE_Y, 4, 0}, // 0xB7 *LAX zpg,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xB8 CLV impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xB9 LDA abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xBA TSX impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xBB *LAS abs,Y
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xBC LDY abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0xBD LDA abs,X
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xBE LDX abs,Y
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xBF *LAX abs,Y
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xC0 CPY #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0xC1 CMP X,ind
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xC2 *NOP #
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0xC3 *DCP X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xC4 CPY zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xC5 CMP zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0xC6 DEC zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0xC7 *DCP zpg
+    {ADDR_MODE::NONE, 2, 0}, // 0xC8 INY impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xC9 CMP #
+    {ADDR_MODE::NONE, 2, 0}, // 0xCA DEX impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xCB *SBX #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xCC CPY abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xCD CMP abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0xCE DEC abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0xCF *DCP abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0xD0 BNE rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0xD1 CMP ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xD2 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0xD3 *DCP ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0xD4 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0xD5 CMP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0xD6 DEC zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0xD7 *DCP zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0xD8 CLD impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xD9 CMP abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xDA *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0xDB *DCP abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0xDC *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0xDD CMP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0xDE DEC abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0xDF *DCP abs,X
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xE0 CPX #
+    {ADDR_MODE::INDIRECT_X, 6, 0}, // 0xE1 SBC X,ind
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xE2 *NOP #
+    {ADDR_MODE::INDIRECT_X, 8, 0}, // 0xE3 *ISC X,ind
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xE4 CPX zpg
+    {ADDR_MODE::ZEROPAGE, 3, 0}, // 0xE5 SBC zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0xE6 INC zpg
+    {ADDR_MODE::ZEROPAGE, 5, 0}, // 0xE7 *ISC zpg
+    {ADDR_MODE::NONE, 2, 0}, // 0xE8 INX impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xE9 SBC #
+    {ADDR_MODE::NONE, 2, 0}, // 0xEA NOP impl
+    {ADDR_MODE::IMMEDIATE, 2, 0}, // 0xEB *SBC #
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xEC CPX abs
+    {ADDR_MODE::ABSOLUTE, 4, 0}, // 0xED SBC abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0xEE INC abs
+    {ADDR_MODE::ABSOLUTE, 6, 0}, // 0xEF *ISC abs
+    {ADDR_MODE::RELATIVE, 2, 1}, // 0xF0 BEQ rel
+    {ADDR_MODE::INDIRECT_Y, 5, 1}, // 0xF1 SBC ind,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xF2 *JAM impl
+    {ADDR_MODE::INDIRECT_Y, 8, 0}, // 0xF3 *ISC ind,Y
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0xF4 *NOP zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 4, 0}, // 0xF5 SBC zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0xF6 INC zpg,X
+    {ADDR_MODE::ZEROPAGE_X, 6, 0}, // 0xF7 *ISC zpg,X
+    {ADDR_MODE::NONE, 2, 0}, // 0xF8 SED impl
+    {ADDR_MODE::ABSOLUTE_Y, 4, 1}, // 0xF9 SBC abs,Y
+    {ADDR_MODE::NONE, 2, 0}, // 0xFA *NOP impl
+    {ADDR_MODE::ABSOLUTE_Y, 7, 0}, // 0xFB *ISC abs,Y
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0xFC *NOP abs,X
+    {ADDR_MODE::ABSOLUTE_X, 4, 1}, // 0xFD SBC abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0xFE INC abs,X
+    {ADDR_MODE::ABSOLUTE_X, 7, 0}, // 0xFF *ISC abs,X
+};
+
+// Quantidade de bytes de operando de cada modo de endereçamento
+// (na mesma ordem de ADDR_MODE)
+constexpr uint8_t operandSizes[] = {1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 1, 0};
+
+constexpr uint8_t operandSize(uint8_t opcode) {
+  return operandSizes[static_cast<int>(opcodeInfo[opcode].addrMode)];
+}
+
+// Opcodes KIL/JAM (0x?2, exceto LDX # 0xA2 e os NOPs 0x82, 0xC2 e 0xE2)
+constexpr bool isJam(uint8_t opcode) {
+  return (opcode & 0x0F) == 0x02 && (opcode < 0x80 || (opcode & 0x10) != 0);
+}
+
+// Instruções que desviam o fluxo do programa (encerram um bloco)
+constexpr bool isControlFlow(uint8_t opcode) {
+  return (opcode & 0x1F) == 0x10 || opcode == 0x00 || opcode == 0x20 ||
+         opcode == 0x40 || opcode == 0x4C || opcode == 0x60 ||
+         opcode == 0x6C || isJam(opcode);
+}
+
+#endif
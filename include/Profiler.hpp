@@ -0,0 +1,60 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Instrumentação de execução: compilada apenas com -DBYTENES_PROFILER
+// (ex.: make CXX="clang++ ... -DBYTENES_PROFILER"). Sem a flag, as chamadas
+// a record() são removidas em tempo de compilação.
+#ifdef BYTENES_PROFILER
+const bool PROFILER_ENABLED = true;
+#else
+const bool PROFILER_ENABLED = false;
+#endif
+
+// Contagem de execuções e ciclos de um endereço
+struct ProfileEntry {
+  uint16_t pc;
+  uint8_t opcode;
+  uint64_t count;
+  uint64_t cycles;
+};
+
+// Execuções e ciclos por opcode e por endereço (PC)
+class Profiler {
+public:
+  Profiler();
+  ~Profiler();
+
+  void record(uint16_t pc, uint8_t opcode, uint8_t cycles) {
+    opcodeCount[opcode]++;
+    opcodeCycles[opcode] += cycles;
+    pcCount[pc]++;
+    pcCycles[pc] += cycles;
+    pcOpcode[pc] = opcode;
+  }
+
+  void clear();
+
+  // Os "n" endereços mais executados, em ordem decrescente
+  std::vector<ProfileEntry> topAddresses(size_t n) const;
+
+  void exportCSV(std::ostream &out) const;
+  void exportJSON(std::ostream &out) const;
+  // Formato escolhido pela extensão (".json" ou CSV)
+  bool exportToFile(const std::string &path) const;
+
+private:
+  std::array<uint64_t, 0x100> opcodeCount{};
+  std::array<uint64_t, 0x100> opcodeCycles{};
+  // Alocados apenas com o profiler habilitado
+  std::vector<uint64_t> pcCount;
+  std::vector<uint64_t> pcCycles;
+  std::vector<uint8_t> pcOpcode;
+};
+
+#endif
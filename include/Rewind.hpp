@@ -0,0 +1,66 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Cpu.hpp"
+#include "Mem.hpp"
+
+// Estado de um quadro no histórico
+struct RewindFrame {
+  CpuSnapshot cpu;
+  uint32_t randomState;
+  // Memória do quadro XOR a do quadro anterior, em RLE: pares (zeros,
+  // literais) com os tamanhos em varint seguidos dos bytes literais.
+  // Vazio no quadro mais antigo.
+  std::vector<uint8_t> delta;
+};
+
+// Histórico para voltar no tempo (um estado por quadro da interface).
+// O último estado fica completo em "head"; cada quadro guarda a diferença
+// para o anterior, então voltar um quadro é aplicar o XOR do topo e
+// descartá-lo. O custo por quadro é limitado: uma passada de 64 KiB para
+// codificar e outra para restaurar as páginas que mudaram. A fila do
+// Scheduler volta junto com a CPU (ver SaveState.hpp).
+class RewindBuffer {
+public:
+  // Limites do histórico (o quadro mais antigo é descartado ao excedê-los);
+  // 3600 quadros = 1 minuto a 60 Hz
+  RewindBuffer(Cpu &cpu, Memory &memory, size_t maxFrames = 3600,
+               size_t maxBytes = 8 << 20);
+  ~RewindBuffer();
+
+  // Registra o estado atual como um novo quadro
+  void push();
+  // Restaura o quadro anterior ao último registrado (que é descartado);
+  // false quando só resta o quadro mais antigo (que é restaurado)
+  bool rewind();
+  void clear();
+
+  size_t getFrames() const;
+  // Bytes usados pelas diferenças comprimidas
+  size_t getBytes() const;
+
+private:
+  Cpu &cpu;
+  Memory &memory;
+  size_t maxFrames;
+  size_t maxBytes;
+
+  std::deque<RewindFrame> frames;
+  // Memória do último quadro registrado
+  std::array<uint8_t, MEMSIZE> head;
+  size_t bytes{};
+  size_t dirtyConsumer;
+
+  void encode(std::vector<uint8_t> &delta, const DirtyRegions &dirty);
+  void decode(const std::vector<uint8_t> &delta);
+  // Copia "head" e o estado do quadro no topo para a máquina
+  void restoreTop();
+};
+
+#endif
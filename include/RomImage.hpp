@@ -0,0 +1,31 @@
+#ifndef ROM_IMAGE_H
+#define ROM_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Arquivo de ROM/programa mapeado em memória (somente leitura). O conteúdo
+// é lido diretamente da imagem (sem cópia nem leitura byte a byte), e as
+// páginas só são carregadas do disco quando acessadas.
+class RomImage {
+public:
+  explicit RomImage(const std::string &path);
+  ~RomImage();
+  RomImage(const RomImage &) = delete;
+  RomImage &operator=(const RomImage &) = delete;
+
+  // false se o arquivo não pôde ser aberto (um arquivo vazio é válido)
+  bool isOpen() const { return open; }
+  const uint8_t *getData() const { return bytes; }
+  size_t getSize() const { return size; }
+  const std::string &getPath() const { return path; }
+
+private:
+  std::string path;
+  bool open{false};
+  const uint8_t *bytes{nullptr};
+  size_t size{};
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SAVE_STATE_H
+#define SAVE_STATE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Cpu.hpp"
+#include "Mem.hpp"
+
+// Página de 256 bytes imutável, compartilhada entre snapshots
+using SnapshotPage = std::shared_ptr<const std::array<uint8_t, 0x100>>;
+
+// Snapshot da máquina (CPU, gerador de $FE e as 256 páginas da memória)
+struct SaveState {
+  CpuSnapshot cpu;
+  uint32_t randomState;
+  std::array<SnapshotPage, 0x100> pages;
+  // Páginas copiadas por este snapshot (as demais são compartilhadas com o
+  // snapshot anterior)
+  size_t copiedPages;
+};
+
+// Save states em memória com cópia na escrita por página: um snapshot só
+// copia as páginas escritas desde o snapshot/restauração anterior e
+// compartilha as outras; a restauração só regrava as páginas que diferem
+// do estado atual (escritas desde então ou diferentes na base).
+// Usa as regiões alteradas da Memory (consumidor próprio).
+// A fila do Scheduler volta com o snapshot (cada evento à mesma distância
+// do ciclo salvo), mas não o estado interno dos dispositivos (contadores,
+// bancos do mapper etc.); os dispositivos com eventos no snapshot precisam
+// existir enquanto ele puder ser restaurado.
+class SaveStates {
+public:
+  SaveStates(Cpu &cpu, Memory &memory);
+  ~SaveStates();
+
+  std::shared_ptr<const SaveState> save();
+  void load(const SaveState &state);
+
+  // Páginas copiadas pelos snapshots / regravadas pelas restaurações
+  uint64_t getCopiedPages() const;
+  uint64_t getRestoredPages() const;
+
+private:
+  Cpu &cpu;
+  Memory &memory;
+  size_t dirtyConsumer;
+
+  // Conteúdo das páginas no último save/load (base do próximo snapshot)
+  std::array<SnapshotPage, 0x100> base;
+  bool hasBase{false};
+
+  uint64_t copiedPages{};
+  uint64_t restoredPages{};
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Scheduler;
+
+// Dispositivo com eventos marcados em ciclos da CPU (vblank da PPU, frame
+// counter da APU, IRQ de mappers, timers)
+class ScheduledDevice {
+public:
+  virtual ~ScheduledDevice() {}
+  // Chamado ao fim da instrução que alcançou "cycle" (o ciclo agendado).
+  // Pode agendar o próximo evento e acionar as linhas de interrupção da CPU.
+  virtual void onEvent(uint64_t cycle, uint32_t tag, Scheduler &scheduler) = 0;
+};
+
+// Identificador de um evento agendado (para cancelamento)
+using EventId = uint64_t;
+
+// Evento pendente, com o ciclo relativo a uma origem (snapshots da CPU)
+struct ScheduledEvent {
+  uint64_t delay;
+  EventId id;
+  ScheduledDevice *device;
+  uint32_t tag;
+};
+
+// Fila de eventos ordenada por ciclo (min-heap; eventos no mesmo ciclo saem
+// na ordem em que foram agendados). A CPU executa sem consultar os
+// dispositivos até o ciclo do próximo evento.
+class Scheduler {
+public:
+  Scheduler();
+  ~Scheduler();
+
+  EventId schedule(uint64_t cycle, ScheduledDevice *device, uint32_t tag = 0);
+  void cancel(EventId id);
+  void cancelAll(ScheduledDevice *device);
+  void clear();
+
+  // Ciclo do próximo evento (UINT64_MAX se não houver)
+  uint64_t nextEvent() const {
+    return heap.empty() ? UINT64_MAX : heap.front().cycle;
+  }
+  // Dispara, em ordem, os eventos com ciclo <= "cycle"
+  void dispatch(uint64_t cycle);
+  // Subtrai "origin" dos ciclos agendados (a CPU zera o contador no reset)
+  void rebase(uint64_t origin);
+  // Eventos pendentes a partir de "origin" (atrasados ficam com 0) e
+  // substituição da fila por eles, a partir da nova origem. Os ids são
+  // mantidos: cancel continua valendo para os eventos restaurados.
+  std::vector<ScheduledEvent> saveEvents(uint64_t origin) const;
+  void restoreEvents(const std::vector<ScheduledEvent> &events,
+                     uint64_t origin);
+
+  size_t size() const;
+
+private:
+  struct Event {
+    uint64_t cycle;
+    EventId id;
+    ScheduledDevice *device;
+    uint32_t tag;
+  };
+  // Ordem do heap: o evento mais antigo fica em heap.front()
+  static bool later(const Event &a, const Event &b);
+
+  std::vector<Event> heap;
+  EventId nextId{1};
+};
+
+#endif
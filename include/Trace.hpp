@@ -0,0 +1,69 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Registro das últimas instruções executadas (sempre ligado). Desligar apenas
+// para medir o custo do registro.
+const bool TRACE_ENABLED = true;
+
+// Estado da CPU antes de uma instrução, sem alocação nem formatação
+struct TraceRecord {
+  uint64_t cycle;   // Ciclos executados antes da instrução
+  uint16_t pc;
+  uint16_t operand; // Bytes de operando (tamanho dado por operandSize)
+  uint8_t opcode;
+  uint8_t AC;
+  uint8_t X;
+  uint8_t Y;
+  uint8_t SP;
+  uint8_t SR;
+};
+
+// Buffer circular de tamanho fixo com as últimas instruções executadas
+// (também as do código nativo do Jit).
+// O conteúdo pode ser despejado no formato do log do nestest:
+// C000  4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:24 SP:FD CYC:7
+class TraceBuffer {
+public:
+  // Potência de 2 (índice por máscara)
+  static const size_t CAPACITY = 1 << 12;
+  // Tamanho máximo de uma linha formatada: desmontagem até a coluna 48,
+  // registradores ("A:.. X:.. Y:.. P:.. SP:.. CYC:", 30), até 20 dígitos
+  // de ciclos e o '\n'
+  static const size_t LINE_SIZE = 48 + 30 + 20 + 1;
+
+  TraceBuffer();
+  ~TraceBuffer();
+
+  // Próximo registro do buffer (sobrescreve o mais antigo)
+  TraceRecord &push() { return records[head++ & (CAPACITY - 1)]; }
+
+  size_t size() const;
+  // i = 0 é o registro mais antigo ainda no buffer
+  const TraceRecord &at(size_t i) const;
+  void clear();
+
+  // Formata uma linha em "out" (ao menos LINE_SIZE bytes) e retorna o seu
+  // tamanho. Não aloca memória: pode ser chamada no tratamento de sinais.
+  static size_t format(const TraceRecord &record, char *out);
+
+  // Despeja os "n" registros mais recentes
+  void dump(std::ostream &out, size_t n = CAPACITY) const;
+  bool dumpToFile(const std::string &path, size_t n = CAPACITY) const;
+  void dumpToFd(int fd, size_t n = CAPACITY) const;
+
+  // Despeja o buffer em stderr se o processo receber SIGSEGV, SIGBUS,
+  // SIGILL, SIGFPE ou SIGABRT (apenas um buffer por processo)
+  static void installCrashHandler(const TraceBuffer *buffer);
+
+private:
+  std::vector<TraceRecord> records;
+  uint64_t head{};
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef TRACE_COMPARE_H
+#define TRACE_COMPARE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Cpu.hpp"
+
+// Estado lido de uma linha do log de referência
+struct ReferenceState {
+  uint16_t pc;
+  uint8_t AC;
+  uint8_t X;
+  uint8_t Y;
+  uint8_t SR;
+  uint8_t SP;
+  uint64_t cycle;
+  bool hasCycle; // Linha com o campo CYC:
+};
+
+// Compara a execução, instrução a instrução, com um log de referência no
+// formato do nestest (PC no início da linha; A:, X:, Y:, P:, SP: e CYC:).
+// O log é lido em blocos grandes e comparado enquanto é lido, sem carregá-lo
+// inteiro. Os registradores são sincronizados com a primeira linha e os
+// ciclos são comparados em relação a ela.
+class TraceComparer {
+public:
+  TraceComparer(Cpu &cpu);
+  ~TraceComparer();
+
+  // Bits de P comparados (padrão 0xCF: B e o bit 5 não existem no
+  // registrador e variam entre emuladores)
+  void setStatusMask(uint8_t mask);
+  void setCompareCycles(bool enable);
+  // Linhas de referência anteriores mostradas na divergência
+  void setContextLines(size_t lines);
+
+  // Compara até "maxLines" linhas; false na primeira divergência ou se o log
+  // não puder ser lido
+  bool run(const std::string &path, uint64_t maxLines = UINT64_MAX);
+
+  uint64_t getLines();
+  bool hasMismatch();
+  void report(std::ostream &out);
+
+private:
+  Cpu &cpu;
+  uint8_t statusMask{0xCF};
+  bool compareCycles{true};
+  size_t contextLines{8};
+
+  uint64_t lines{};
+  std::string error;
+
+  // Primeira divergência
+  bool mismatch{false};
+  uint64_t mismatchLine{};
+  std::string field;
+  std::string expected;
+  std::string actual;
+  // Últimas linhas de referência (buffer circular)
+  std::vector<std::string> context;
+  size_t contextHead{};
+
+  void remember(const char *line, size_t size);
+};
+
+#endif
@@ -2,21 +2,22 @@
 #include <string>
 
 
- const std::array<std::string, 0xFF>  opcodesList {
-    "BRK impl", "ORA X,ind", "⚠️ ",    "⚠️ ", "⚠️ ",        "ORA zpg",   "ASL zpg",   "⚠️ ", "PHP impl", "ORA #",     "ASL A",    "⚠️ ", "⚠️ ",        "ORA abs",   "ASL abs",   "⚠️ ",
-    "BPL rel",  "ORA ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "ORA zpg,X", "ASL zpg,X", "⚠️ ", "CLC impl", "ORA abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "ORA abs,X", "ASL abs,X", "⚠️ ",
-    "JSR abs",  "AND X,ind", "⚠️ ",    "⚠️ ", "BIT zpg",   "AND zpg",   "ROL zpg",   "⚠️ ", "PLP impl", "AND #",     "ROL A",    "⚠️ ", "BIT abs",   "AND abs",   "ROL abs",   "⚠️ ",
-    "BMI rel",  "AND ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "AND zpg,X", "ROL zpg,X", "⚠️ ", "SEC impl", "AND abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "AND abs,X", "ROL abs,X", "⚠️ ",
-    "RTI impl", "EOR X,ind", "⚠️ ",    "⚠️ ", "⚠️ ",        "EOR zpg",   "LSR zpg",   "⚠️ ", "PHA impl", "EOR #",     "LSR A",    "⚠️ ", "JMP abs",   "EOR abs",   "LSR abs",   "⚠️ ",
-    "BVC rel",  "EOR ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "EOR zpg,X", "LSR zpg,X", "⚠️ ", "CLI impl", "EOR abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "EOR abs,X", "LSR abs,X", "⚠️ ",
-    "RTS impl", "ADC X,ind", "⚠️ ",    "⚠️ ", "⚠️ ",        "ADC zpg",   "ROR zpg",   "⚠️ ", "PLA impl", "ADC #",     "ROR A",    "⚠️ ", "JMP ind",   "ADC abs",   "ROR abs",   "⚠️ ",
-    "BVS rel",  "ADC ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "ADC zpg,X", "ROR zpg,X", "⚠️ ", "SEI impl", "ADC abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "ADC abs,X", "ROR abs,X", "⚠️ ",
-    "⚠️ ",       "STA X,ind", "⚠️ ",    "⚠️ ", "STY zpg",   "STA zpg",   "STX zpg",   "⚠️ ", "DEY impl", "⚠️ ",        "TXA impl", "⚠️ ", "STY abs",   "STA abs",   "STX abs",   "⚠️ ",
-    "BCC rel",  "STA ind,Y", "⚠️ ",    "⚠️ ", "STY zpg,X", "STA zpg,X", "STX zpg,Y", "⚠️ ", "TYA impl", "STA abs,Y", "TXS impl", "⚠️ ", "⚠️ ",        "STA abs,X", "⚠️ ",        "⚠️ ",
-    "LDY #",    "LDA X,ind", "LDX #", "⚠️ ", "LDY zpg",   "LDA zpg",   "LDX zpg",   "⚠️ ", "TAY impl", "LDA #",     "TAX impl", "⚠️ ", "LDY abs",   "LDA abs,X", "LDX abs",   "⚠️ ",
-    "BCS rel",  "LDA ind,Y", "⚠️ ",    "⚠️ ", "LDY zpg,X", "LDA zpg,X", "LDX zpg,Y", "⚠️ ", "CLV impl", "LDA abs,Y", "TSX impl", "⚠️ ", "LDY abs,X", "LDA abs,X", "LDX abs,Y", "⚠️ ",
-    "CPY #",    "CMP X,ind", "⚠️ ",    "⚠️ ", "CPY zpg",   "CMP zpg",   "DEC zpg",   "⚠️ ", "INY impl", "CMP #",     "DEX impl", "⚠️ ", "CPY abs",   "CMP abs",   "DEC abs",   "⚠️ ",
-    "BNE rel",  "CMP ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "CMP zpg,X", "DEC zpg,X", "⚠️ ", "CLD impl", "CMP abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "CMP abs,X", "DEC abs,X", "⚠️ ",
-    "CPX #",    "SBC X,ind", "⚠️ ",    "⚠️ ", "CPX zpg",   "SBC zpg",   "INC zpg",   "⚠️ ", "INX impl", "SBC #",     "NOP impl", "⚠️ ", "CPX abs",   "SBC abs",   "INC abs",   "⚠️ ",
-    "BEQ rel",  "SBC ind,Y", "⚠️ ",    "⚠️ ", "⚠️ ",        "SBC zpg,X", "INC zpg,X", "⚠️ ", "SED impl", "SBC abs,Y", "⚠️ ",       "⚠️ ", "⚠️ ",        "SBC abs,X", "INC abs,X"  "⚠️ ",
-  };
+// Nome de cada opcode ("*" indica os não oficiais)
+const std::array<std::string, 0x100> opcodesList{
+    "BRK impl", "ORA X,ind", "*JAM impl", "*SLO X,ind", "*NOP zpg", "ORA zpg", "ASL zpg", "*SLO zpg", "PHP impl", "ORA #", "ASL A", "*ANC #", "*NOP abs", "ORA abs", "ASL abs", "*SLO abs",
+    "BPL rel", "ORA ind,Y", "*JAM impl", "*SLO ind,Y", "*NOP zpg,X", "ORA zpg,X", "ASL zpg,X", "*SLO zpg,X", "CLC impl", "ORA abs,Y", "*NOP impl", "*SLO abs,Y", "*NOP abs,X", "ORA abs,X", "ASL abs,X", "*SLO abs,X",
+    "JSR abs", "AND X,ind", "*JAM impl", "*RLA X,ind", "BIT zpg", "AND zpg", "ROL zpg", "*RLA zpg", "PLP impl", "AND #", "ROL A", "*ANC #", "BIT abs", "AND abs", "ROL abs", "*RLA abs",
+    "BMI rel", "AND ind,Y", "*JAM impl", "*RLA ind,Y", "*NOP zpg,X", "AND zpg,X", "ROL zpg,X", "*RLA zpg,X", "SEC impl", "AND abs,Y", "*NOP impl", "*RLA abs,Y", "*NOP abs,X", "AND abs,X", "ROL abs,X", "*RLA abs,X",
+    "RTI impl", "EOR X,ind", "*JAM impl", "*SRE X,ind", "*NOP zpg", "EOR zpg", "LSR zpg", "*SRE zpg", "PHA impl", "EOR #", "LSR A", "*ALR #", "JMP abs", "EOR abs", "LSR abs", "*SRE abs",
+    "BVC rel", "EOR ind,Y", "*JAM impl", "*SRE ind,Y", "*NOP zpg,X", "EOR zpg,X", "LSR zpg,X", "*SRE zpg,X", "CLI impl", "EOR abs,Y", "*NOP impl", "*SRE abs,Y", "*NOP abs,X", "EOR abs,X", "LSR abs,X", "*SRE abs,X",
+    "RTS impl", "ADC X,ind", "*JAM impl", "*RRA X,ind", "*NOP zpg", "ADC zpg", "ROR zpg", "*RRA zpg", "PLA impl", "ADC #", "ROR A", "*ARR #", "JMP ind", "ADC abs", "ROR abs", "*RRA abs",
+    "BVS rel", "ADC ind,Y", "*JAM impl", "*RRA ind,Y", "*NOP zpg,X", "ADC zpg,X", "ROR zpg,X", "*RRA zpg,X", "SEI impl", "ADC abs,Y", "*NOP impl", "*RRA abs,Y", "*NOP abs,X", "ADC abs,X", "ROR abs,X", "*RRA abs,X",
+    "*NOP #", "STA X,ind", "*NOP #", "*SAX X,ind", "STY zpg", "STA zpg", "STX zpg", "*SAX zpg", "DEY impl", "*NOP #", "TXA impl", "*XAA #", "STY abs", "STA abs", "STX abs", "*SAX abs",
+    "BCC rel", "STA ind,Y", "*JAM impl", "*SHA ind,Y", "STY zpg,X", "STA zpg,X", "STX zpg,Y", "*SAX zpg,Y", "TYA impl", "STA abs,Y", "TXS impl", "*TAS abs,Y", "*SHY abs,X", "STA abs,X", "*SHX abs,Y", "*SHA abs,Y",
+    "LDY #", "LDA X,ind", "LDX #", "*LAX X,ind", "LDY zpg", "LDA zpg", "LDX zpg", "*LAX zpg", "TAY impl", "LDA #", "TAX impl", "*LXA #", "LDY abs", "LDA abs", "LDX abs", "*LAX abs",
+    "BCS rel", "LDA ind,Y", "*JAM impl", "*LAX ind,Y", "LDY zpg,X", "LDA zpg,X", "LDX zpg,Y", "*LAX zpg,Y", "CLV impl", "LDA abs,Y", "TSX impl", "*LAS abs,Y", "LDY abs,X", "LDA abs,X", "LDX abs,Y", "*LAX abs,Y",
+    "CPY #", "CMP X,ind", "*NOP #", "*DCP X,ind", "CPY zpg", "CMP zpg", "DEC zpg", "*DCP zpg", "INY impl", "CMP #", "DEX impl", "*SBX #", "CPY abs", "CMP abs", "DEC abs", "*DCP abs",
+    "BNE rel", "CMP ind,Y", "*JAM impl", "*DCP ind,Y", "*NOP zpg,X", "CMP zpg,X", "DEC zpg,X", "*DCP zpg,X", "CLD impl", "CMP abs,Y", "*NOP impl", "*DCP abs,Y", "*NOP abs,X", "CMP abs,X", "DEC abs,X", "*DCP abs,X",
+    "CPX #", "SBC X,ind", "*NOP #", "*ISC X,ind", "CPX zpg", "SBC zpg", "INC zpg", "*ISC zpg", "INX impl", "SBC #", "NOP impl", "*SBC #", "CPX abs", "SBC abs", "INC abs", "*ISC abs",
+    "BEQ rel", "SBC ind,Y", "*JAM impl", "*ISC ind,Y", "*NOP zpg,X", "SBC zpg,X", "INC zpg,X", "*ISC zpg,X", "SED impl", "SBC abs,Y", "*NOP impl", "*ISC abs,Y", "*NOP abs,X", "SBC abs,X", "INC abs,X", "*ISC abs,X",
+};
@@ -1,18 +1,44 @@
-
 #include "Cpu.hpp"
 #include "Gui.hpp"
+#include "Mapper.hpp"
 #include "Mem.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
 
-int main() {
+// Sem argumento carrega asm/program.bin em $0600; um arquivo .nes é ligado
+// ao mapper do cabeçalho e começa no vetor de reset
+int main(int argc, char **argv) {
+  const std::string path = argc > 1 ? argv[1] : "asm/program.bin";
 
   Memory mem;
   mem.fillZeroData();
   // mem.fillRandomData();
   mem.enableSaveStatusToFile(false);
-  mem.loadMemoryFromFile("asm/program.bin", 0x0600);
+
+  std::unique_ptr<Cartridge> cartridge;
+  std::unique_ptr<Mapper> mapper;
+  uint16_t start = 0x0600;
+  if (isCartridgePath(path)) {
+    cartridge.reset(new Cartridge(path));
+    mapper = createMapper(*cartridge, mem);
+    if (!mapper) {
+      std::cerr << "Error in load cartridge \"" << path << "\": "
+                << (cartridge->isOpen()
+                        ? "unsupported mapper " +
+                              std::to_string(cartridge->getHeader().mapper)
+                        : cartridge->getError())
+                << "\n";
+      return 1;
+    }
+    start = mem.peek(0xFFFC) | (mem.peek(0xFFFD) << 8);
+  } else {
+    mem.loadMemoryFromFile(path, start);
+  }
 
   Cpu cpu(mem);
-  cpu.setAsmAddress(0x0600);
+  cpu.setAsmAddress(start);
+  TraceBuffer::installCrashHandler(&cpu.getTrace());
 
   Gui gui(cpu);
   gui.show();
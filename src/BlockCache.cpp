@@ -0,0 +1,93 @@
+#include "BlockCache.hpp"
+#include "Opcodes.hpp"
+#include <algorithm>
+
+BlockCache::BlockCache(Memory &memory) : memory(memory) {}
+
+BlockCache::~BlockCache() {}
+
+Block *BlockCache::lookup(uint16_t pc) {
+  if (blocks.empty()) {
+    blocks.resize(0x10000);
+  }
+
+  std::unique_ptr<Block> &block = blocks[pc];
+  if (block) {
+    hits++;
+    return block.get();
+  }
+
+  misses++;
+  block.reset(new Block());
+  decode(pc, *block);
+  return block.get();
+}
+
+// Decodifica instruções a partir de pc até um desvio, o fim do espaço de
+// endereçamento ou MAX_BLOCK_SIZE instruções
+void BlockCache::decode(uint16_t pc, Block &block) {
+  block.start = pc;
+  block.ops.clear();
+
+  uint32_t address = pc;
+  while (block.ops.size() < MAX_BLOCK_SIZE) {
+    uint8_t opcode = memory.peek(address);
+    uint8_t size = operandSize(opcode);
+
+    // Os operandos seguem a mesma aritmética de 16 bits do interpretador
+    uint16_t operand = 0;
+    if (size > 0) {
+      operand = memory.peek(address + 1);
+    }
+    if (size > 1) {
+      operand |= memory.peek(address + 2) << 8;
+    }
+    block.ops.push_back({static_cast<uint16_t>(address), operand, opcode});
+
+    for (uint32_t i = address; i <= address + size; i++) {
+      uint8_t page = (i >> 8) & 0xFF;
+      std::vector<uint16_t> &starts = pageBlocks[page];
+      if (std::find(starts.begin(), starts.end(), pc) == starts.end()) {
+        starts.push_back(pc);
+      }
+      memory.watchPage(page);
+    }
+
+    address += size + 1;
+    if (isControlFlow(opcode) || address > 0xFFFF) {
+      break;
+    }
+  }
+}
+
+void BlockCache::invalidatePage(uint8_t page) {
+  std::vector<uint16_t> &starts = pageBlocks[page];
+  for (uint16_t start : starts) {
+    if (blocks[start]) {
+      blocks[start].reset();
+      invalidations++;
+    }
+  }
+  starts.clear();
+  memory.unwatchPage(page);
+  generation++;
+}
+
+void BlockCache::clear() {
+  for (auto &block : blocks) {
+    block.reset();
+  }
+  for (size_t page = 0; page < pageBlocks.size(); page++) {
+    pageBlocks[page].clear();
+    memory.unwatchPage(page);
+  }
+  generation++;
+}
+
+void BlockCache::onPageWrite(uint8_t page) { invalidatePage(page); }
+
+uint64_t BlockCache::getHits() const { return hits; }
+
+uint64_t BlockCache::getMisses() const { return misses; }
+
+uint64_t BlockCache::getInvalidations() const { return invalidations; }
@@ -0,0 +1,124 @@
+#include "Cartridge.hpp"
+#include <cstring>
+
+namespace {
+
+const size_t HEADER_SIZE = 16;
+const size_t TRAINER_SIZE = 512;
+
+// NES 2.0: com o nibble mais significativo 0xF, o byte menos significativo
+// é EEEEEEMM e o tamanho é 2^E * (MM * 2 + 1)
+size_t romSize(uint8_t lsb, uint8_t msb, size_t unit) {
+  if (msb == 0x0F) {
+    const unsigned exponent = lsb >> 2;
+    if (exponent >= sizeof(size_t) * 8) {
+      return 0;
+    }
+    return (static_cast<size_t>(1) << exponent) * ((lsb & 0x03) * 2 + 1);
+  }
+  return ((static_cast<size_t>(msb) << 8) | lsb) * unit;
+}
+
+// NES 2.0: 64 << n bytes (0 sem RAM)
+size_t ramSize(uint8_t shift) { return shift == 0 ? 0 : 64u << shift; }
+
+} // namespace
+
+bool parseCartridgeHeader(const uint8_t *bytes, size_t size,
+                          CartridgeHeader &header, std::string &error) {
+  if (size < HEADER_SIZE || std::memcmp(bytes, "NES\x1A", 4) != 0) {
+    error = "Not an iNES file";
+    return false;
+  }
+  const uint8_t flags6 = bytes[6];
+  const uint8_t flags7 = bytes[7];
+  header.nes20 = (flags7 & 0x0C) == 0x08;
+  header.battery = flags6 & 0x02;
+  header.trainer = flags6 & 0x04;
+  if (flags6 & 0x08) {
+    header.mirroring = Mirroring::FOUR_SCREEN;
+  } else {
+    header.mirroring =
+        (flags6 & 0x01) ? Mirroring::VERTICAL : Mirroring::HORIZONTAL;
+  }
+
+  if (header.nes20) {
+    header.mapper =
+        (flags6 >> 4) | (flags7 & 0xF0) | ((bytes[8] & 0x0F) << 8);
+    header.submapper = bytes[8] >> 4;
+    header.prgRomSize = romSize(bytes[4], bytes[9] & 0x0F, 0x4000);
+    header.chrRomSize = romSize(bytes[5], bytes[9] >> 4, 0x2000);
+    header.prgRamSize = ramSize(bytes[10] & 0x0F) + ramSize(bytes[10] >> 4);
+    header.chrRamSize = ramSize(bytes[11] & 0x0F) + ramSize(bytes[11] >> 4);
+  } else {
+    // Cabeçalhos antigos ("DiskDude!") sujam os bytes 7 a 15: sem o nibble
+    // alto do mapper
+    const bool dirty =
+        bytes[12] != 0 || bytes[13] != 0 || bytes[14] != 0 || bytes[15] != 0;
+    header.mapper = (flags6 >> 4) | (dirty ? 0 : (flags7 & 0xF0));
+    header.submapper = 0;
+    header.prgRomSize = bytes[4] * static_cast<size_t>(0x4000);
+    header.chrRomSize = bytes[5] * static_cast<size_t>(0x2000);
+    header.prgRamSize = (dirty || bytes[8] == 0 ? 1 : bytes[8]) * 0x2000;
+    header.chrRamSize = header.chrRomSize == 0 ? 0x2000 : 0;
+  }
+
+  if (header.prgRomSize == 0) {
+    error = "No PRG ROM";
+    return false;
+  }
+  // Os mappers trocam PRG em janelas de 8 KiB e CHR em janelas de 1 KiB; o
+  // formato exponencial do NES 2.0 permite tamanhos que não as preenchem
+  if (header.prgRomSize % 0x2000 != 0) {
+    error = "PRG ROM size " + std::to_string(header.prgRomSize) +
+            " is not a multiple of 8 KiB";
+    return false;
+  }
+  if (header.chrRomSize % 0x400 != 0) {
+    error = "CHR ROM size " + std::to_string(header.chrRomSize) +
+            " is not a multiple of 1 KiB";
+    return false;
+  }
+  const size_t needed = HEADER_SIZE + (header.trainer ? TRAINER_SIZE : 0) +
+                        header.prgRomSize + header.chrRomSize;
+  if (needed > size) {
+    error = "Truncated file (" + std::to_string(size) + " of " +
+            std::to_string(needed) + " bytes)";
+    return false;
+  }
+  return true;
+}
+
+Cartridge::Cartridge(const std::string &path) : image(path) {
+  if (!image.isOpen()) {
+    error = "Could not open " + path;
+    return;
+  }
+  if (!parseCartridgeHeader(image.getData(), image.getSize(), header,
+                            error)) {
+    return;
+  }
+
+  const uint8_t *bytes = image.getData() + HEADER_SIZE;
+  if (header.trainer) {
+    trainer = bytes;
+    bytes += TRAINER_SIZE;
+  }
+  prg = bytes;
+  if (header.chrRomSize > 0) {
+    chr = bytes + header.prgRomSize;
+    chrSize = header.chrRomSize;
+  } else {
+    chrRam.assign(header.chrRamSize > 0 ? header.chrRamSize : 0x2000, 0);
+    chr = chrRam.data();
+    chrSize = chrRam.size();
+  }
+}
+
+Cartridge::~Cartridge() {}
+
+bool isCartridgePath(const std::string &path) {
+  return path.size() >= 4 &&
+         (path.compare(path.size() - 4, 4, ".nes") == 0 ||
+          path.compare(path.size() - 4, 4, ".NES") == 0);
+}
@@ -1,4 +1,5 @@
 #include "Cpu.hpp"
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <cstddef>
@@ -9,350 +10,13 @@
 #include <iostream>
 #include <ostream>
 
-Cpu::Cpu(Memory &memory) : memory(memory) { fillOpcodeMapping(); }
-
-Cpu::~Cpu() {}
-
-void Cpu::fillOpcodeMapping() {
-
-  /*// ADC (ADd with Carry)*/
-  opcodeMapping[0x69] = &Cpu::ADC;
-  opcodeMapping[0x65] = &Cpu::ADC;
-  opcodeMapping[0x75] = &Cpu::ADC;
-  opcodeMapping[0x6D] = &Cpu::ADC;
-  opcodeMapping[0x7D] = &Cpu::ADC;
-  opcodeMapping[0x79] = &Cpu::ADC;
-  opcodeMapping[0x61] = &Cpu::ADC;
-  opcodeMapping[0x71] = &Cpu::ADC;
-  opcodeInfo[0x69] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0x65] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x75] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0x6D] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0x7D] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0x79] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0x61] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0x71] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// AND (bitwise AND with accumulator)*/
-  opcodeMapping[0x29] = &Cpu::AND;
-  opcodeMapping[0x25] = &Cpu::AND;
-  opcodeMapping[0x35] = &Cpu::AND;
-  opcodeMapping[0x2D] = &Cpu::AND;
-  opcodeMapping[0x3D] = &Cpu::AND;
-  opcodeMapping[0x39] = &Cpu::AND;
-  opcodeMapping[0x21] = &Cpu::AND;
-  opcodeMapping[0x31] = &Cpu::AND;
-  opcodeInfo[0x29] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0x25] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x35] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0x2D] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0x3D] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0x39] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0x21] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0x31] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// ASL (Arithmetic Shift Left)*/
-  opcodeMapping[0x0A] = &Cpu::ASL_AC;
-  opcodeMapping[0x06] = &Cpu::ASL;
-  opcodeMapping[0x16] = &Cpu::ASL;
-  opcodeMapping[0x0E] = &Cpu::ASL;
-  opcodeMapping[0x1E] = &Cpu::ASL;
-  opcodeInfo[0x0A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x06] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0x16] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0x0E] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0x1E] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// BIT (test BITs)*/
-  opcodeMapping[0x24] = &Cpu::BIT;
-  opcodeMapping[0x2C] = &Cpu::BIT;
-  opcodeInfo[0x24] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x2C] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  /*// Branch Instructions*/
-  opcodeMapping[0x10] = &Cpu::BPL;
-  opcodeMapping[0x30] = &Cpu::BMI;
-  opcodeMapping[0x50] = &Cpu::BVC;
-  opcodeMapping[0x70] = &Cpu::BVS;
-  opcodeMapping[0x90] = &Cpu::BCC;
-  opcodeMapping[0xB0] = &Cpu::BCS;
-  opcodeMapping[0xD0] = &Cpu::BNE;
-  opcodeMapping[0xF0] = &Cpu::BEQ;
-  opcodeInfo[0x10] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0x30] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0x50] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0x70] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0x90] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0xB0] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0xD0] = {ADDR_MODE::RELATIVE, 2, 1};
-  opcodeInfo[0xF0] = {ADDR_MODE::RELATIVE, 2, 1};
-  /*// BRK (BReaK)*/
-  opcodeMapping[0x00] = &Cpu::BRK;
-  opcodeInfo[0x00] = {ADDR_MODE::NONE, 7, 0};
-  /*// CMP (CoMPare accumulator)*/
-  opcodeMapping[0xC9] = &Cpu::CMP;
-  opcodeMapping[0xC5] = &Cpu::CMP;
-  opcodeMapping[0xD5] = &Cpu::CMP;
-  opcodeMapping[0xCD] = &Cpu::CMP;
-  opcodeMapping[0xDD] = &Cpu::CMP;
-  opcodeMapping[0xD9] = &Cpu::CMP;
-  opcodeMapping[0xC1] = &Cpu::CMP;
-  opcodeMapping[0xD1] = &Cpu::CMP;
-  opcodeInfo[0xC9] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xC5] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xD5] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0xCD] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0xDD] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0xD9] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0xC1] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0xD1] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// CPX (ComPare X register)*/
-  opcodeMapping[0xE0] = &Cpu::CPX;
-  opcodeMapping[0xE4] = &Cpu::CPX;
-  opcodeMapping[0xEC] = &Cpu::CPX;
-  opcodeInfo[0xE0] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xE4] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xEC] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  /*// CPY (ComPare Y register)*/
-  opcodeMapping[0xC0] = &Cpu::CPY;
-  opcodeMapping[0xC4] = &Cpu::CPY;
-  opcodeMapping[0xCC] = &Cpu::CPY;
-  opcodeInfo[0xC0] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xC4] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xCC] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  /*// DEC (DECrement memory)*/
-  opcodeMapping[0xC6] = &Cpu::DEC;
-  opcodeMapping[0xD6] = &Cpu::DEC;
-  opcodeMapping[0xCE] = &Cpu::DEC;
-  opcodeMapping[0xDE] = &Cpu::DEC;
-  opcodeInfo[0xC6] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0xD6] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0xCE] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0xDE] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// EOR (bitwise Exclusive OR)*/
-  opcodeMapping[0x49] = &Cpu::EOR;
-  opcodeMapping[0x45] = &Cpu::EOR;
-  opcodeMapping[0x55] = &Cpu::EOR;
-  opcodeMapping[0x4D] = &Cpu::EOR;
-  opcodeMapping[0x5D] = &Cpu::EOR;
-  opcodeMapping[0x59] = &Cpu::EOR;
-  opcodeMapping[0x41] = &Cpu::EOR;
-  opcodeMapping[0x51] = &Cpu::EOR;
-  opcodeInfo[0x49] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0x45] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x55] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0x4D] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0x5D] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0x59] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0x41] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0x51] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// Flag (Processor Status) Instructions*/
-  opcodeMapping[0x18] = &Cpu::CLC;
-  opcodeMapping[0x38] = &Cpu::SEC;
-  opcodeMapping[0x58] = &Cpu::CLI;
-  opcodeMapping[0x78] = &Cpu::SEI;
-  opcodeMapping[0xB8] = &Cpu::CLV;
-  opcodeMapping[0xD8] = &Cpu::CLD;
-  opcodeMapping[0xF8] = &Cpu::SED;
-  opcodeInfo[0x18] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x38] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x58] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x78] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xB8] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xD8] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xF8] = {ADDR_MODE::NONE, 2, 0};
-  /*// INC (INCrement memory)*/
-  opcodeMapping[0xE6] = &Cpu::INC;
-  opcodeMapping[0xF6] = &Cpu::INC;
-  opcodeMapping[0xEE] = &Cpu::INC;
-  opcodeMapping[0xFE] = &Cpu::INC;
-  opcodeInfo[0xE6] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0xF6] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0xEE] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0xFE] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// JMP (JuMP)*/
-  opcodeMapping[0x4C] = &Cpu::JMP;
-  opcodeMapping[0x6C] = &Cpu::JMP;
-  opcodeInfo[0x4C] = {ADDR_MODE::ABSOLUTE, 3, 0};
-  opcodeInfo[0x6C] = {ADDR_MODE::INDIRECT, 5, 0};
-  /*// JSR (Jump to SubRoutine)*/
-  opcodeMapping[0x20] = &Cpu::JSR;
-  opcodeInfo[0x20] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  /**/
-  /*// LDA (LoaD Accumulator)*/
-  opcodeMapping[0xA9] = &Cpu::LDA;
-  opcodeMapping[0xA5] = &Cpu::LDA;
-  opcodeMapping[0xB5] = &Cpu::LDA;
-  opcodeMapping[0xAD] = &Cpu::LDA;
-  opcodeMapping[0xBD] = &Cpu::LDA;
-  opcodeMapping[0xB9] = &Cpu::LDA;
-  opcodeMapping[0xA1] = &Cpu::LDA;
-  opcodeMapping[0xB1] = &Cpu::LDA;
-  opcodeInfo[0xA9] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xA5] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xB5] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0xAD] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0xBD] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0xB9] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0xA1] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0xB1] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// LDX (LoaD X register)*/
-  opcodeMapping[0xA2] = &Cpu::LDX;
-  opcodeMapping[0xA6] = &Cpu::LDX;
-  opcodeMapping[0xB6] = &Cpu::LDX;
-  opcodeMapping[0xAE] = &Cpu::LDX;
-  opcodeMapping[0xBE] = &Cpu::LDX;
-  opcodeInfo[0xA2] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xA6] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xB6] = {ADDR_MODE::ZEROPAGE_Y, 4, 0};
-  opcodeInfo[0xAE] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0xBE] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  /*// LDY (LoaD Y register)*/
-  opcodeMapping[0xA0] = &Cpu::LDY;
-  opcodeMapping[0xA4] = &Cpu::LDY;
-  opcodeMapping[0xB4] = &Cpu::LDY;
-  opcodeMapping[0xAC] = &Cpu::LDY;
-  opcodeMapping[0xBC] = &Cpu::LDY;
-  opcodeInfo[0xA0] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xA4] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xB4] = {ADDR_MODE::ZEROPAGE_Y, 4, 0};
-  opcodeInfo[0xAC] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0xBC] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  /*// LSR (Logical Shift Right)*/
-  opcodeMapping[0x4A] = &Cpu::LSR_AC;
-  opcodeMapping[0x46] = &Cpu::LSR;
-  opcodeMapping[0x56] = &Cpu::LSR;
-  opcodeMapping[0x4E] = &Cpu::LSR;
-  opcodeMapping[0x5E] = &Cpu::LSR;
-  opcodeInfo[0x4A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x46] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0x56] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0x4E] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0x5E] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// NOP (No OPeration)*/
-  opcodeMapping[0xEA] = &Cpu::NOP;
-  opcodeInfo[0xEA] = {ADDR_MODE::NONE, 2, 0};
-  /*// ORA (bitwise OR with Accumulator)*/
-  opcodeMapping[0x09] = &Cpu::ORA;
-  opcodeMapping[0x05] = &Cpu::ORA;
-  opcodeMapping[0x15] = &Cpu::ORA;
-  opcodeMapping[0x0D] = &Cpu::ORA;
-  opcodeMapping[0x1D] = &Cpu::ORA;
-  opcodeMapping[0x19] = &Cpu::ORA;
-  opcodeMapping[0x01] = &Cpu::ORA;
-  opcodeMapping[0x11] = &Cpu::ORA;
-  opcodeInfo[0x09] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0x05] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x15] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0x0D] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0x1D] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0x19] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0x01] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0x11] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// Register Instructions*/
-  opcodeMapping[0xAA] = &Cpu::TAX;
-  opcodeMapping[0x8A] = &Cpu::TXA;
-  opcodeMapping[0xCA] = &Cpu::DEX;
-  opcodeMapping[0xE8] = &Cpu::INX;
-  opcodeMapping[0xA8] = &Cpu::TAY;
-  opcodeMapping[0x98] = &Cpu::TYA;
-  opcodeMapping[0x88] = &Cpu::DEY;
-  opcodeMapping[0xC8] = &Cpu::INY;
-  opcodeInfo[0xAA] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x8A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xCA] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xE8] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xA8] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x98] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x88] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xC8] = {ADDR_MODE::NONE, 2, 0};
-  /*// ROL (ROtate Left)*/
-  opcodeMapping[0x2A] = &Cpu::ROL_AC;
-  opcodeMapping[0x26] = &Cpu::ROL;
-  opcodeMapping[0x36] = &Cpu::ROL;
-  opcodeMapping[0x2E] = &Cpu::ROL;
-  opcodeMapping[0x3E] = &Cpu::ROL;
-  opcodeInfo[0x2A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x26] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0x36] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0x2E] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0x3E] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// ROR (ROtate Right)*/
-  opcodeMapping[0x6A] = &Cpu::ROR_AC;
-  opcodeMapping[0x66] = &Cpu::ROR;
-  opcodeMapping[0x76] = &Cpu::ROR;
-  opcodeMapping[0x6E] = &Cpu::ROR;
-  opcodeMapping[0x7E] = &Cpu::ROR;
-  opcodeInfo[0x6A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x66] = {ADDR_MODE::ZEROPAGE, 5, 0};
-  opcodeInfo[0x76] = {ADDR_MODE::ZEROPAGE_X, 6, 0};
-  opcodeInfo[0x6E] = {ADDR_MODE::ABSOLUTE, 6, 0};
-  opcodeInfo[0x7E] = {ADDR_MODE::ABSOLUTE_X, 7, 0};
-  /*// RTI (ReTurn from Interrupt)*/
-  opcodeMapping[0x40] = &Cpu::RTI;
-  opcodeInfo[0x40] = {ADDR_MODE::NONE, 6, 0};
-  // RTS (ReTurn from Subroutine)
-  opcodeMapping[0x60] = &Cpu::RTS;
-  opcodeInfo[0x60] = {ADDR_MODE::NONE, 6, 0};
-  // SBC (SuBtract with Carry)
-  opcodeMapping[0xE9] = &Cpu::SBC;
-  opcodeMapping[0xE5] = &Cpu::SBC;
-  opcodeMapping[0xF5] = &Cpu::SBC;
-  opcodeMapping[0xED] = &Cpu::SBC;
-  opcodeMapping[0xFD] = &Cpu::SBC;
-  opcodeMapping[0xF9] = &Cpu::SBC;
-  opcodeMapping[0xE1] = &Cpu::SBC;
-  opcodeMapping[0xF1] = &Cpu::SBC;
-  opcodeInfo[0xE9] = {ADDR_MODE::IMMEDIATE, 2, 0};
-  opcodeInfo[0xE5] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0xF5] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0xED] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0xFD] = {ADDR_MODE::ABSOLUTE_X, 4, 1};
-  opcodeInfo[0xF9] = {ADDR_MODE::ABSOLUTE_Y, 4, 1};
-  opcodeInfo[0xE1] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0xF1] = {ADDR_MODE::INDIRECT_Y, 5, 1};
-  /*// STA (STore Accumulator)*/
-  opcodeMapping[0x85] = &Cpu::STA;
-  opcodeMapping[0x95] = &Cpu::STA;
-  opcodeMapping[0x8D] = &Cpu::STA;
-  opcodeMapping[0x9D] = &Cpu::STA;
-  opcodeMapping[0x99] = &Cpu::STA;
-  opcodeMapping[0x81] = &Cpu::STA;
-  opcodeMapping[0x91] = &Cpu::STA;
-  opcodeInfo[0x85] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x95] = {ADDR_MODE::ZEROPAGE_X, 4, 0};
-  opcodeInfo[0x8D] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  opcodeInfo[0x9D] = {ADDR_MODE::ABSOLUTE_X, 5, 0};
-  opcodeInfo[0x99] = {ADDR_MODE::ABSOLUTE_Y, 5, 0};
-  opcodeInfo[0x81] = {ADDR_MODE::INDIRECT_X, 6, 0};
-  opcodeInfo[0x91] = {ADDR_MODE::INDIRECT_Y, 6, 0};
-  /*// Stack Instructions*/
-  opcodeMapping[0x9A] = &Cpu::TXS;
-  opcodeMapping[0xBA] = &Cpu::TSX;
-  /*static_cast<void>(Addressingmode);*/
-  /*auto response = getValueAddrMode(params.addrMode);*/
-  opcodeMapping[0x48] = &Cpu::PHA;
-  opcodeMapping[0x68] = &Cpu::PLA;
-  opcodeMapping[0x08] = &Cpu::PHP;
-  opcodeMapping[0x28] = &Cpu::PLP;
-  opcodeInfo[0x9A] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0xBA] = {ADDR_MODE::NONE, 2, 0};
-  opcodeInfo[0x48] = {ADDR_MODE::NONE, 3, 0};
-  opcodeInfo[0x68] = {ADDR_MODE::NONE, 4, 0};
-  opcodeInfo[0x08] = {ADDR_MODE::NONE, 3, 0};
-  opcodeInfo[0x28] = {ADDR_MODE::NONE, 4, 0};
-  /*// STX (STore X register)*/
-  opcodeMapping[0x86] = &Cpu::STX;
-  opcodeMapping[0x96] = &Cpu::STX;
-  opcodeMapping[0x8E] = &Cpu::STX;
-  opcodeInfo[0x86] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x96] = {ADDR_MODE::ZEROPAGE_Y, 4, 0};
-  opcodeInfo[0x8E] = {ADDR_MODE::ABSOLUTE, 4, 0};
-  /*// STY (STore Y register)*/
-  opcodeMapping[0x84] = &Cpu::STY;
-  opcodeMapping[0x94] = &Cpu::STY;
-  opcodeMapping[0x8C] = &Cpu::STY;
-  opcodeInfo[0x84] = {ADDR_MODE::ZEROPAGE, 3, 0};
-  opcodeInfo[0x94] = {ADDR_MODE::ZEROPAGE_Y, 4, 0};
-  opcodeInfo[0x8C] = {ADDR_MODE::ABSOLUTE, 4, 0};
-
-  srand(time(NULL));
+Cpu::Cpu(Memory &memory) : memory(memory), blockCache(memory), jit(*this) {}
+
+// A Memory pode sobreviver à CPU (e ao cache de blocos que a observa)
+Cpu::~Cpu() {
+  if (blockCacheEnabled) {
+    memory.setPageWatcher(nullptr);
+  }
 }
 
 void Cpu::setAsmAddress(uint16_t address) {
@@ -366,13 +30,123 @@ uint8_t Cpu::getSP() { return SP; }
 uint8_t Cpu::getAC() { return AC; }
 uint8_t Cpu::getX() { return X; }
 uint8_t Cpu::getY() { return Y; }
-uint8_t Cpu::getSR() { return SR; }
+uint8_t Cpu::getSR() {
+  return (SR & 0x3C) | (nResult & 0x80) | (overflowFlag << 6) |
+         (zResult == 0 ? 0x02 : 0x00) | carryFlag;
+}
+CpuState Cpu::getState() { return {PC, SP, AC, X, Y, getSR()}; }
+void Cpu::setState(const CpuState &state) {
+  PC = state.PC;
+  SP = state.SP;
+  AC = state.AC;
+  X = state.X;
+  Y = state.Y;
+  setSR(state.SR);
+}
+
+CpuSnapshot Cpu::saveSnapshot() {
+  return {getState(), cycles, count, jammed, nmiPending, irqLines,
+          scheduler.saveEvents(cycles)};
+}
+
+// A memória pode ter mudado junto: o bloco atual e o laço ocioso analisado
+// são descartados (o cache é invalidado pelas notificações de página)
+void Cpu::loadSnapshot(const CpuSnapshot &snapshot) {
+  setState(snapshot.registers);
+  cycles = snapshot.cycles;
+  count = snapshot.count;
+  jammed = snapshot.jammed;
+  nmiPending = snapshot.nmiPending;
+  irqLines = snapshot.irqLines;
+  // Os eventos voltam à mesma distância do ciclo restaurado
+  scheduler.restoreEvents(snapshot.events, cycles);
+  blockCursor = blockEnd = nullptr;
+  idleLoop = IdleLoop();
+}
+bool Cpu::isJammed() { return jammed; }
+
+void Cpu::enableIdleSkip(bool enable) {
+  idleSkipEnabled = enable;
+  idleLoop = IdleLoop();
+}
+uint64_t Cpu::getSkippedInstructions() { return skippedInstructions; }
+uint64_t Cpu::getSkippedCycles() { return skippedCycles; }
+
+Scheduler &Cpu::getScheduler() { return scheduler; }
+void Cpu::triggerNMI() { nmiPending = true; }
+void Cpu::setIRQ(bool active, uint8_t source) {
+  if (active) {
+    irqLines |= 1u << (source & 0x1F);
+  } else {
+    irqLines &= ~(1u << (source & 0x1F));
+  }
+}
 
 uint64_t Cpu::getCount() { return count; }
+uint64_t Cpu::getCycles() { return cycles; }
 
-void Cpu::setFlag(Flag flag) { SR = SR | static_cast<uint8_t>(flag); }
-void Cpu::remFlag(Flag flag) { SR = SR & ~(static_cast<uint8_t>(flag)); }
-bool Cpu::chkFlag(Flag flag) { return (SR & static_cast<uint8_t>(flag)) != 0; }
+void Cpu::setSR(uint8_t value) {
+  SR = value;
+  nResult = value;
+  zResult = (value & 0x02) ? 0x00 : 0x01;
+  carryFlag = value & 0x01;
+  overflowFlag = (value >> 6) & 0x01;
+}
+
+void Cpu::setFlag(Flag flag) {
+  switch (flag) {
+  case Flag::N:
+    nResult = 0x80;
+    break;
+  case Flag::Z:
+    zResult = 0x00;
+    break;
+  case Flag::C:
+    carryFlag = 0x01;
+    break;
+  case Flag::V:
+    overflowFlag = 0x01;
+    break;
+  default:
+    SR = SR | static_cast<uint8_t>(flag);
+    break;
+  }
+}
+
+void Cpu::remFlag(Flag flag) {
+  switch (flag) {
+  case Flag::N:
+    nResult = 0x00;
+    break;
+  case Flag::Z:
+    zResult = 0x01;
+    break;
+  case Flag::C:
+    carryFlag = 0x00;
+    break;
+  case Flag::V:
+    overflowFlag = 0x00;
+    break;
+  default:
+    SR = SR & ~(static_cast<uint8_t>(flag));
+    break;
+  }
+}
+
+bool Cpu::chkFlag(Flag flag) {
+  switch (flag) {
+  case Flag::N:
+    return (nResult & 0x80) != 0;
+  case Flag::Z:
+    return zResult == 0;
+  case Flag::C:
+    return carryFlag != 0;
+  case Flag::V:
+    return overflowFlag != 0;
+  default:
+    return (SR & static_cast<uint8_t>(flag)) != 0;
+  }
+}
 
 void Cpu::incrementPC(uint16_t value) { PC += value; }
 void Cpu::decrementPC(uint16_t value) { PC -= value; }
@@ -396,16 +170,6 @@ uint8_t Cpu::stackPOP() {
   return value;
 }
 
-// Específico do emulador do endereço
-// https://skilldrick.github.io/easy6502/
-// O endereço 0xFE é reservado para geração
-// de numeros aleatórios.
-// IMPORTANTE: Não é comportamente nativo do 6502.
-void Cpu::generateRandomIn0xFE() {
-  uint8_t random = (rand() % 0xFF) + 1;
-  memory.write(0xFE, random);
-}
-
 void Cpu::showCpuStatus(uint8_t index, bool showOpcodes) {
   if (showOpcodes) {
     std::cout << "| [" << count << "] " << std::dec;
@@ -418,23 +182,1236 @@ void Cpu::showCpuStatus(uint8_t index, bool showOpcodes) {
             << std::hex << std::setw(4) << (int)AC
             << " | X: " << std::setfill('0') << std::hex << std::setw(4)
             << (int)X << " | Y: " << std::setfill('0') << std::hex
-            << std::setw(4) << (int)Y << " | SR: " << std::bitset<8>(SR)
+            << std::setw(4) << (int)Y << " | SR: " << std::bitset<8>(getSR())
             << "]\n";
   std::cout << "                                                           "
                "NV_BDIZC\n";
 }
 
+TraceRecord *Cpu::traceInstruction(uint8_t opcode, uint64_t cycle) {
+  if (!TRACE_ENABLED) {
+    return nullptr;
+  }
+  TraceRecord &record = trace.push();
+  record.cycle = cycle;
+  record.pc = PC;
+  record.opcode = opcode;
+  record.AC = AC;
+  record.X = X;
+  record.Y = Y;
+  record.SP = SP;
+  record.SR = getSR();
+  return &record;
+}
+
 uint8_t Cpu::next() {
-  generateRandomIn0xFE();
-  uint8_t index = memory.read(PC);
+  const uint16_t pc = PC;
+  const uint8_t opcode = memory.peek(PC);
+  TraceRecord *record = traceInstruction(opcode, cycles);
+  CPUCicles executed =
+      blockCacheEnabled ? nextFromCache() : execute<true>(opcode);
+  if (TRACE_ENABLED) {
+    record->operand = operand;
+  }
+  cycles += executed;
+  count++;
+  if (PROFILER_ENABLED) {
+    profiler.record(pc, opcode, executed);
+  }
+  return executed;
+}
+
+RunSummary Cpu::runInstructions(uint64_t count) {
+  return runBudget(count, UINT64_MAX);
+}
+
+RunSummary Cpu::runCycles(uint64_t cycles) {
+  return runBudget(UINT64_MAX, cycles);
+}
+
+RunSummary Cpu::runUntilPC(uint16_t pc, uint64_t maxInstructions) {
+  return runLoop(maxInstructions, UINT64_MAX,
+                 [pc](Cpu &cpu) { return cpu.PC == pc; }, StopReason::PC);
+}
+
+RunSummary Cpu::runUntilBRK(uint64_t maxInstructions) {
+  return runLoop(maxInstructions, UINT64_MAX,
+                 [](Cpu &cpu) { return cpu.memory.peek(cpu.PC) == 0x00; },
+                 StopReason::BRK);
+}
+
+// A execução é dividida em fatias que terminam no próximo evento agendado:
+// dentro de uma fatia nenhum dispositivo é consultado
+RunSummary Cpu::runBudget(uint64_t maxInstructions, uint64_t maxCycles) {
+  RunSummary summary{0, 0, StopReason::BUDGET};
+  while (summary.instructions < maxInstructions &&
+         summary.cycles < maxCycles) {
+    if (cycles >= eventDeadline()) {
+      handleEvents(summary);
+    }
+    if (jammed) {
+      summary.reason = StopReason::JAM;
+      break;
+    }
+    // Com uma IRQ mascarada pendente, uma instrução por fatia
+    const uint64_t deadline = eventDeadline();
+    const uint64_t untilEvent = deadline > cycles ? deadline - cycles : 1;
+    runSlice(summary, maxInstructions,
+             untilEvent < maxCycles - summary.cycles
+                 ? summary.cycles + untilEvent
+                 : maxCycles);
+  }
+  return summary;
+}
+
+// Com o Jit, blocos inteiros são executados enquanto couberem no orçamento;
+// o restante segue instrução por instrução. Depois de cada desvio para trás,
+// iterações de laços ociosos podem ser puladas.
+void Cpu::runSlice(RunSummary &summary, uint64_t maxInstructions,
+                   uint64_t maxCycles) {
+  // Pior caso de ciclos por instrução (7 + desvio + página cruzada)
+  const uint64_t maxBlockCycles = BlockCache::MAX_BLOCK_SIZE * 9;
+  // Com o profiler, cada instrução precisa ser registrada
+  const bool skipIdle = idleSkipEnabled && !PROFILER_ENABLED;
+
+  if (jitEnabled) {
+    while (maxInstructions - summary.instructions >=
+               BlockCache::MAX_BLOCK_SIZE &&
+           maxCycles - summary.cycles >= maxBlockCycles && !jammed) {
+      const uint16_t pc = PC;
+      BlockRun run = nextBlock();
+      summary.instructions += run.instructions;
+      summary.cycles += run.cycles;
+      if (skipIdle && PC <= pc) {
+        skipIdleLoop(summary, maxInstructions, maxCycles);
+      }
+    }
+  }
+
+  while (summary.instructions < maxInstructions &&
+         summary.cycles < maxCycles && !jammed) {
+    const uint16_t pc = PC;
+    summary.cycles += next();
+    summary.instructions++;
+    if (skipIdle && PC <= pc) {
+      skipIdleLoop(summary, maxInstructions, maxCycles);
+    }
+  }
+}
+
+void Cpu::handleEvents(RunSummary &summary) {
+  if (cycles >= scheduler.nextEvent()) {
+    scheduler.dispatch(cycles);
+  }
+  // A CPU travada não atende interrupções
+  if (jammed) {
+    return;
+  }
+  if (nmiPending) {
+    nmiPending = false;
+    summary.cycles += interrupt(0xFFFA);
+  } else if (irqLines != 0 && !chkFlag(Flag::I)) {
+    summary.cycles += interrupt(0xFFFE);
+  }
+}
+
+// Mesma ordem de pilha do BRK/RTI deste emulador (SR, PC lsb, PC msb), com o
+// bit B limpo no SR empilhado
+Cpu::CPUCicles Cpu::interrupt(uint16_t vector) {
+  stackPUSH(getSR() & ~static_cast<uint8_t>(Flag::B));
+  stackPUSH(static_cast<uint8_t>(PC & 0xFF));
+  stackPUSH(static_cast<uint8_t>(PC >> 8));
+  setFlag(Flag::I);
+  PC = (memory.read(vector + 1) << 8) | memory.read(vector);
+  const CPUCicles interruptCycles = 7;
+  cycles += interruptCycles;
+  return interruptCycles;
+}
+
+// Avança iterações inteiras de um laço ocioso sem executá-las. Os ciclos de
+// uma iteração são medidos entre as duas últimas chegadas ao início do laço.
+// - Estado igual ao da chegada anterior: o laço espera por uma mudança
+//   externa (entrada do usuário entre chamadas de run*) e é repetido até o
+//   fim do orçamento.
+// - Só o contador mudou (de "step"): pula até a última iteração, que é
+//   executada normalmente.
+// As iterações puladas não aparecem no trace.
+void Cpu::skipIdleLoop(RunSummary &summary, uint64_t maxInstructions,
+                       uint64_t maxCycles) {
+  const CpuState state = getState();
+  const CpuState previous = idleState;
+  const uint64_t iterationCycles = cycles - idleCycles;
+  const uint64_t iterationCount = count - idleCount;
+  idleState = state;
+  idleCycles = cycles;
+  idleCount = count;
+
+  if (!idleLoop.valid || idleLoop.head != PC) {
+    idleLoop = analyzeIdleLoop(memory, PC);
+    return;
+  }
+  if (!idleLoop.idle || iterationCount != idleLoop.length ||
+      previous.PC != PC ||
+      summary.instructions >= maxInstructions || summary.cycles >= maxCycles) {
+    return;
+  }
+  // O código pode ter mudado desde a análise
+  idleLoop = analyzeIdleLoop(memory, PC);
+  if (!idleLoop.idle) {
+    return;
+  }
+
+  uint64_t iterations =
+      std::min((maxInstructions - summary.instructions) / idleLoop.length,
+               (maxCycles - summary.cycles) / iterationCycles);
+  if (state != previous) {
+    if (idleLoop.counter == IdleCounter::NONE) {
+      return;
+    }
+    uint8_t &reg = idleLoop.counter == IdleCounter::X ? X : Y;
+    const uint8_t last = idleLoop.counter == IdleCounter::X ? previous.X
+                                                            : previous.Y;
+    // Apenas o contador (e as flags N/Z dele) pode ter mudado
+    const uint8_t flagsNZ = static_cast<uint8_t>(Flag::N) |
+                            static_cast<uint8_t>(Flag::Z);
+    if (reg == 0 || static_cast<uint8_t>(last + idleLoop.step) != reg ||
+        state.AC != previous.AC || state.SP != previous.SP ||
+        (idleLoop.counter == IdleCounter::X ? state.Y != previous.Y
+                                            : state.X != previous.X) ||
+        (state.SR & ~flagsNZ) != (previous.SR & ~flagsNZ)) {
+      return;
+    }
+    // Iterações restantes até o contador chegar a zero (a última fica
+    // para o interpretador)
+    const uint64_t remaining = idleLoop.step < 0 ? reg : 0x100 - reg;
+    iterations = std::min(iterations, remaining - 1);
+    reg += idleLoop.step * static_cast<int>(iterations);
+    flagActivationN(reg);
+    flagActivationZ(reg);
+    idleState = getState();
+  }
+  if (iterations == 0) {
+    return;
+  }
 
-  return (this->*opcodeMapping[index])(opcodeInfo[index]);
+  const uint64_t skipped = iterations * idleLoop.length;
+  const uint64_t skippedLoopCycles = iterations * iterationCycles;
+  count += skipped;
+  cycles += skippedLoopCycles;
+  summary.instructions += skipped;
+  summary.cycles += skippedLoopCycles;
+  skippedInstructions += skipped;
+  skippedCycles += skippedLoopCycles;
+  idleCount = count;
+  idleCycles = cycles;
+}
+
+// Lê os bytes de operando da instrução em PC; o tamanho vem do modo de
+// endereçamento do opcode e é resolvido em tempo de compilação
+template <bool FETCH, uint8_t OP> void Cpu::fetchOperand() {
+  if (!FETCH) {
+    return;
+  }
+  constexpr uint8_t size = operandSize(OP);
+  if (size == 0) {
+    return;
+  }
+  operand = memory.peek(PC + 1);
+  if (size == 2) {
+    operand |= memory.peek(PC + 2) << 8;
+  }
+}
+
+// Busca a próxima instrução no bloco atual; ao sair do bloco (desvio, fim do
+// bloco ou invalidação por escrita no código) procura o bloco do novo PC
+Cpu::CPUCicles Cpu::nextFromCache() {
+  if (blockCursor == blockEnd || blockGeneration != blockCache.getGeneration() ||
+      blockCursor->pc != PC) {
+    const Block *block = blockCache.lookup(PC);
+    blockCursor = block->ops.data();
+    blockEnd = blockCursor + block->ops.size();
+    blockGeneration = blockCache.getGeneration();
+  }
+
+  const MicroOp &op = *blockCursor++;
+  operand = op.operand;
+  return execute<false>(op.opcode);
+}
+
+// Com FETCH o operando é lido da memória; sem ele, já foi decodificado
+// (cache de blocos)
+template <bool FETCH> Cpu::CPUCicles Cpu::execute(uint8_t index) {
+  // Cada case é uma instância do handler com modo de endereçamento e ciclos
+  // resolvidos em tempo de compilação; o switch denso vira uma jump table.
+  switch (index) {
+  // ADC (ADd with Carry)
+  case 0x69:
+    fetchOperand<FETCH, 0x69>();
+    return ADC<0x69>();
+  case 0x65:
+    fetchOperand<FETCH, 0x65>();
+    return ADC<0x65>();
+  case 0x75:
+    fetchOperand<FETCH, 0x75>();
+    return ADC<0x75>();
+  case 0x6D:
+    fetchOperand<FETCH, 0x6D>();
+    return ADC<0x6D>();
+  case 0x7D:
+    fetchOperand<FETCH, 0x7D>();
+    return ADC<0x7D>();
+  case 0x79:
+    fetchOperand<FETCH, 0x79>();
+    return ADC<0x79>();
+  case 0x61:
+    fetchOperand<FETCH, 0x61>();
+    return ADC<0x61>();
+  case 0x71:
+    fetchOperand<FETCH, 0x71>();
+    return ADC<0x71>();
+  // AND (bitwise AND with accumulator)
+  case 0x29:
+    fetchOperand<FETCH, 0x29>();
+    return AND<0x29>();
+  case 0x25:
+    fetchOperand<FETCH, 0x25>();
+    return AND<0x25>();
+  case 0x35:
+    fetchOperand<FETCH, 0x35>();
+    return AND<0x35>();
+  case 0x2D:
+    fetchOperand<FETCH, 0x2D>();
+    return AND<0x2D>();
+  case 0x3D:
+    fetchOperand<FETCH, 0x3D>();
+    return AND<0x3D>();
+  case 0x39:
+    fetchOperand<FETCH, 0x39>();
+    return AND<0x39>();
+  case 0x21:
+    fetchOperand<FETCH, 0x21>();
+    return AND<0x21>();
+  case 0x31:
+    fetchOperand<FETCH, 0x31>();
+    return AND<0x31>();
+  // ASL (Arithmetic Shift Left)
+  case 0x0A:
+    fetchOperand<FETCH, 0x0A>();
+    return ASL_AC<0x0A>();
+  case 0x06:
+    fetchOperand<FETCH, 0x06>();
+    return ASL<0x06>();
+  case 0x16:
+    fetchOperand<FETCH, 0x16>();
+    return ASL<0x16>();
+  case 0x0E:
+    fetchOperand<FETCH, 0x0E>();
+    return ASL<0x0E>();
+  case 0x1E:
+    fetchOperand<FETCH, 0x1E>();
+    return ASL<0x1E>();
+  // BIT (test BITs)
+  case 0x24:
+    fetchOperand<FETCH, 0x24>();
+    return BIT<0x24>();
+  case 0x2C:
+    fetchOperand<FETCH, 0x2C>();
+    return BIT<0x2C>();
+  // Branch Instructions
+  case 0x10:
+    fetchOperand<FETCH, 0x10>();
+    return BPL<0x10>();
+  case 0x30:
+    fetchOperand<FETCH, 0x30>();
+    return BMI<0x30>();
+  case 0x50:
+    fetchOperand<FETCH, 0x50>();
+    return BVC<0x50>();
+  case 0x70:
+    fetchOperand<FETCH, 0x70>();
+    return BVS<0x70>();
+  case 0x90:
+    fetchOperand<FETCH, 0x90>();
+    return BCC<0x90>();
+  case 0xB0:
+    fetchOperand<FETCH, 0xB0>();
+    return BCS<0xB0>();
+  case 0xD0:
+    fetchOperand<FETCH, 0xD0>();
+    return BNE<0xD0>();
+  case 0xF0:
+    fetchOperand<FETCH, 0xF0>();
+    return BEQ<0xF0>();
+  // BRK (BReaK)
+  case 0x00:
+    fetchOperand<FETCH, 0x00>();
+    return BRK<0x00>();
+  // CMP (CoMPare accumulator)
+  case 0xC9:
+    fetchOperand<FETCH, 0xC9>();
+    return CMP<0xC9>();
+  case 0xC5:
+    fetchOperand<FETCH, 0xC5>();
+    return CMP<0xC5>();
+  case 0xD5:
+    fetchOperand<FETCH, 0xD5>();
+    return CMP<0xD5>();
+  case 0xCD:
+    fetchOperand<FETCH, 0xCD>();
+    return CMP<0xCD>();
+  case 0xDD:
+    fetchOperand<FETCH, 0xDD>();
+    return CMP<0xDD>();
+  case 0xD9:
+    fetchOperand<FETCH, 0xD9>();
+    return CMP<0xD9>();
+  case 0xC1:
+    fetchOperand<FETCH, 0xC1>();
+    return CMP<0xC1>();
+  case 0xD1:
+    fetchOperand<FETCH, 0xD1>();
+    return CMP<0xD1>();
+  // CPX (ComPare X register)
+  case 0xE0:
+    fetchOperand<FETCH, 0xE0>();
+    return CPX<0xE0>();
+  case 0xE4:
+    fetchOperand<FETCH, 0xE4>();
+    return CPX<0xE4>();
+  case 0xEC:
+    fetchOperand<FETCH, 0xEC>();
+    return CPX<0xEC>();
+  // CPY (ComPare Y register)
+  case 0xC0:
+    fetchOperand<FETCH, 0xC0>();
+    return CPY<0xC0>();
+  case 0xC4:
+    fetchOperand<FETCH, 0xC4>();
+    return CPY<0xC4>();
+  case 0xCC:
+    fetchOperand<FETCH, 0xCC>();
+    return CPY<0xCC>();
+  // DEC (DECrement memory)
+  case 0xC6:
+    fetchOperand<FETCH, 0xC6>();
+    return DEC<0xC6>();
+  case 0xD6:
+    fetchOperand<FETCH, 0xD6>();
+    return DEC<0xD6>();
+  case 0xCE:
+    fetchOperand<FETCH, 0xCE>();
+    return DEC<0xCE>();
+  case 0xDE:
+    fetchOperand<FETCH, 0xDE>();
+    return DEC<0xDE>();
+  // EOR (bitwise Exclusive OR)
+  case 0x49:
+    fetchOperand<FETCH, 0x49>();
+    return EOR<0x49>();
+  case 0x45:
+    fetchOperand<FETCH, 0x45>();
+    return EOR<0x45>();
+  case 0x55:
+    fetchOperand<FETCH, 0x55>();
+    return EOR<0x55>();
+  case 0x4D:
+    fetchOperand<FETCH, 0x4D>();
+    return EOR<0x4D>();
+  case 0x5D:
+    fetchOperand<FETCH, 0x5D>();
+    return EOR<0x5D>();
+  case 0x59:
+    fetchOperand<FETCH, 0x59>();
+    return EOR<0x59>();
+  case 0x41:
+    fetchOperand<FETCH, 0x41>();
+    return EOR<0x41>();
+  case 0x51:
+    fetchOperand<FETCH, 0x51>();
+    return EOR<0x51>();
+  // Flag (Processor Status) Instructions
+  case 0x18:
+    fetchOperand<FETCH, 0x18>();
+    return CLC<0x18>();
+  case 0x38:
+    fetchOperand<FETCH, 0x38>();
+    return SEC<0x38>();
+  case 0x58:
+    fetchOperand<FETCH, 0x58>();
+    return CLI<0x58>();
+  case 0x78:
+    fetchOperand<FETCH, 0x78>();
+    return SEI<0x78>();
+  case 0xB8:
+    fetchOperand<FETCH, 0xB8>();
+    return CLV<0xB8>();
+  case 0xD8:
+    fetchOperand<FETCH, 0xD8>();
+    return CLD<0xD8>();
+  case 0xF8:
+    fetchOperand<FETCH, 0xF8>();
+    return SED<0xF8>();
+  // INC (INCrement memory)
+  case 0xE6:
+    fetchOperand<FETCH, 0xE6>();
+    return INC<0xE6>();
+  case 0xF6:
+    fetchOperand<FETCH, 0xF6>();
+    return INC<0xF6>();
+  case 0xEE:
+    fetchOperand<FETCH, 0xEE>();
+    return INC<0xEE>();
+  case 0xFE:
+    fetchOperand<FETCH, 0xFE>();
+    return INC<0xFE>();
+  // JMP (JuMP)
+  case 0x4C:
+    fetchOperand<FETCH, 0x4C>();
+    return JMP<0x4C>();
+  case 0x6C:
+    fetchOperand<FETCH, 0x6C>();
+    return JMP<0x6C>();
+  // JSR (Jump to SubRoutine)
+  case 0x20:
+    fetchOperand<FETCH, 0x20>();
+    return JSR<0x20>();
+  // LDA (LoaD Accumulator)
+  case 0xA9:
+    fetchOperand<FETCH, 0xA9>();
+    return LDA<0xA9>();
+  case 0xA5:
+    fetchOperand<FETCH, 0xA5>();
+    return LDA<0xA5>();
+  case 0xB5:
+    fetchOperand<FETCH, 0xB5>();
+    return LDA<0xB5>();
+  case 0xAD:
+    fetchOperand<FETCH, 0xAD>();
+    return LDA<0xAD>();
+  case 0xBD:
+    fetchOperand<FETCH, 0xBD>();
+    return LDA<0xBD>();
+  case 0xB9:
+    fetchOperand<FETCH, 0xB9>();
+    return LDA<0xB9>();
+  case 0xA1:
+    fetchOperand<FETCH, 0xA1>();
+    return LDA<0xA1>();
+  case 0xB1:
+    fetchOperand<FETCH, 0xB1>();
+    return LDA<0xB1>();
+  // LDX (LoaD X register)
+  case 0xA2:
+    fetchOperand<FETCH, 0xA2>();
+    return LDX<0xA2>();
+  case 0xA6:
+    fetchOperand<FETCH, 0xA6>();
+    return LDX<0xA6>();
+  case 0xB6:
+    fetchOperand<FETCH, 0xB6>();
+    return LDX<0xB6>();
+  case 0xAE:
+    fetchOperand<FETCH, 0xAE>();
+    return LDX<0xAE>();
+  case 0xBE:
+    fetchOperand<FETCH, 0xBE>();
+    return LDX<0xBE>();
+  // LDY (LoaD Y register)
+  case 0xA0:
+    fetchOperand<FETCH, 0xA0>();
+    return LDY<0xA0>();
+  case 0xA4:
+    fetchOperand<FETCH, 0xA4>();
+    return LDY<0xA4>();
+  case 0xB4:
+    fetchOperand<FETCH, 0xB4>();
+    return LDY<0xB4>();
+  case 0xAC:
+    fetchOperand<FETCH, 0xAC>();
+    return LDY<0xAC>();
+  case 0xBC:
+    fetchOperand<FETCH, 0xBC>();
+    return LDY<0xBC>();
+  // LSR (Logical Shift Right)
+  case 0x4A:
+    fetchOperand<FETCH, 0x4A>();
+    return LSR_AC<0x4A>();
+  case 0x46:
+    fetchOperand<FETCH, 0x46>();
+    return LSR<0x46>();
+  case 0x56:
+    fetchOperand<FETCH, 0x56>();
+    return LSR<0x56>();
+  case 0x4E:
+    fetchOperand<FETCH, 0x4E>();
+    return LSR<0x4E>();
+  case 0x5E:
+    fetchOperand<FETCH, 0x5E>();
+    return LSR<0x5E>();
+  // NOP (No OPeration)
+  case 0xEA:
+    fetchOperand<FETCH, 0xEA>();
+    return NOP<0xEA>();
+  // ORA (bitwise OR with Accumulator)
+  case 0x09:
+    fetchOperand<FETCH, 0x09>();
+    return ORA<0x09>();
+  case 0x05:
+    fetchOperand<FETCH, 0x05>();
+    return ORA<0x05>();
+  case 0x15:
+    fetchOperand<FETCH, 0x15>();
+    return ORA<0x15>();
+  case 0x0D:
+    fetchOperand<FETCH, 0x0D>();
+    return ORA<0x0D>();
+  case 0x1D:
+    fetchOperand<FETCH, 0x1D>();
+    return ORA<0x1D>();
+  case 0x19:
+    fetchOperand<FETCH, 0x19>();
+    return ORA<0x19>();
+  case 0x01:
+    fetchOperand<FETCH, 0x01>();
+    return ORA<0x01>();
+  case 0x11:
+    fetchOperand<FETCH, 0x11>();
+    return ORA<0x11>();
+  // Register Instructions
+  case 0xAA:
+    fetchOperand<FETCH, 0xAA>();
+    return TAX<0xAA>();
+  case 0x8A:
+    fetchOperand<FETCH, 0x8A>();
+    return TXA<0x8A>();
+  case 0xCA:
+    fetchOperand<FETCH, 0xCA>();
+    return DEX<0xCA>();
+  case 0xE8:
+    fetchOperand<FETCH, 0xE8>();
+    return INX<0xE8>();
+  case 0xA8:
+    fetchOperand<FETCH, 0xA8>();
+    return TAY<0xA8>();
+  case 0x98:
+    fetchOperand<FETCH, 0x98>();
+    return TYA<0x98>();
+  case 0x88:
+    fetchOperand<FETCH, 0x88>();
+    return DEY<0x88>();
+  case 0xC8:
+    fetchOperand<FETCH, 0xC8>();
+    return INY<0xC8>();
+  // ROL (ROtate Left)
+  case 0x2A:
+    fetchOperand<FETCH, 0x2A>();
+    return ROL_AC<0x2A>();
+  case 0x26:
+    fetchOperand<FETCH, 0x26>();
+    return ROL<0x26>();
+  case 0x36:
+    fetchOperand<FETCH, 0x36>();
+    return ROL<0x36>();
+  case 0x2E:
+    fetchOperand<FETCH, 0x2E>();
+    return ROL<0x2E>();
+  case 0x3E:
+    fetchOperand<FETCH, 0x3E>();
+    return ROL<0x3E>();
+  // ROR (ROtate Right)
+  case 0x6A:
+    fetchOperand<FETCH, 0x6A>();
+    return ROR_AC<0x6A>();
+  case 0x66:
+    fetchOperand<FETCH, 0x66>();
+    return ROR<0x66>();
+  case 0x76:
+    fetchOperand<FETCH, 0x76>();
+    return ROR<0x76>();
+  case 0x6E:
+    fetchOperand<FETCH, 0x6E>();
+    return ROR<0x6E>();
+  case 0x7E:
+    fetchOperand<FETCH, 0x7E>();
+    return ROR<0x7E>();
+  // RTI (ReTurn from Interrupt)
+  case 0x40:
+    fetchOperand<FETCH, 0x40>();
+    return RTI<0x40>();
+  // RTS (ReTurn from Subroutine)
+  case 0x60:
+    fetchOperand<FETCH, 0x60>();
+    return RTS<0x60>();
+  // SBC (SuBtract with Carry)
+  case 0xE9:
+    fetchOperand<FETCH, 0xE9>();
+    return SBC<0xE9>();
+  case 0xE5:
+    fetchOperand<FETCH, 0xE5>();
+    return SBC<0xE5>();
+  case 0xF5:
+    fetchOperand<FETCH, 0xF5>();
+    return SBC<0xF5>();
+  case 0xED:
+    fetchOperand<FETCH, 0xED>();
+    return SBC<0xED>();
+  case 0xFD:
+    fetchOperand<FETCH, 0xFD>();
+    return SBC<0xFD>();
+  case 0xF9:
+    fetchOperand<FETCH, 0xF9>();
+    return SBC<0xF9>();
+  case 0xE1:
+    fetchOperand<FETCH, 0xE1>();
+    return SBC<0xE1>();
+  case 0xF1:
+    fetchOperand<FETCH, 0xF1>();
+    return SBC<0xF1>();
+  // STA (STore Accumulator)
+  case 0x85:
+    fetchOperand<FETCH, 0x85>();
+    return STA<0x85>();
+  case 0x95:
+    fetchOperand<FETCH, 0x95>();
+    return STA<0x95>();
+  case 0x8D:
+    fetchOperand<FETCH, 0x8D>();
+    return STA<0x8D>();
+  case 0x9D:
+    fetchOperand<FETCH, 0x9D>();
+    return STA<0x9D>();
+  case 0x99:
+    fetchOperand<FETCH, 0x99>();
+    return STA<0x99>();
+  case 0x81:
+    fetchOperand<FETCH, 0x81>();
+    return STA<0x81>();
+  case 0x91:
+    fetchOperand<FETCH, 0x91>();
+    return STA<0x91>();
+  // Stack Instructions
+  case 0x9A:
+    fetchOperand<FETCH, 0x9A>();
+    return TXS<0x9A>();
+  case 0xBA:
+    fetchOperand<FETCH, 0xBA>();
+    return TSX<0xBA>();
+  case 0x48:
+    fetchOperand<FETCH, 0x48>();
+    return PHA<0x48>();
+  case 0x68:
+    fetchOperand<FETCH, 0x68>();
+    return PLA<0x68>();
+  case 0x08:
+    fetchOperand<FETCH, 0x08>();
+    return PHP<0x08>();
+  case 0x28:
+    fetchOperand<FETCH, 0x28>();
+    return PLP<0x28>();
+  // STX (STore X register)
+  case 0x86:
+    fetchOperand<FETCH, 0x86>();
+    return STX<0x86>();
+  case 0x96:
+    fetchOperand<FETCH, 0x96>();
+    return STX<0x96>();
+  case 0x8E:
+    fetchOperand<FETCH, 0x8E>();
+    return STX<0x8E>();
+  // STY (STore Y register)
+  case 0x84:
+    fetchOperand<FETCH, 0x84>();
+    return STY<0x84>();
+  case 0x94:
+    fetchOperand<FETCH, 0x94>();
+    return STY<0x94>();
+  case 0x8C:
+    fetchOperand<FETCH, 0x8C>();
+    return STY<0x8C>();
+  // Opcodes não oficiais
+  // SLO (ASL + ORA)
+  case 0x03:
+    fetchOperand<FETCH, 0x03>();
+    return SLO<0x03>();
+  case 0x07:
+    fetchOperand<FETCH, 0x07>();
+    return SLO<0x07>();
+  case 0x0F:
+    fetchOperand<FETCH, 0x0F>();
+    return SLO<0x0F>();
+  case 0x13:
+    fetchOperand<FETCH, 0x13>();
+    return SLO<0x13>();
+  case 0x17:
+    fetchOperand<FETCH, 0x17>();
+    return SLO<0x17>();
+  case 0x1B:
+    fetchOperand<FETCH, 0x1B>();
+    return SLO<0x1B>();
+  case 0x1F:
+    fetchOperand<FETCH, 0x1F>();
+    return SLO<0x1F>();
+  // RLA (ROL + AND)
+  case 0x23:
+    fetchOperand<FETCH, 0x23>();
+    return RLA<0x23>();
+  case 0x27:
+    fetchOperand<FETCH, 0x27>();
+    return RLA<0x27>();
+  case 0x2F:
+    fetchOperand<FETCH, 0x2F>();
+    return RLA<0x2F>();
+  case 0x33:
+    fetchOperand<FETCH, 0x33>();
+    return RLA<0x33>();
+  case 0x37:
+    fetchOperand<FETCH, 0x37>();
+    return RLA<0x37>();
+  case 0x3B:
+    fetchOperand<FETCH, 0x3B>();
+    return RLA<0x3B>();
+  case 0x3F:
+    fetchOperand<FETCH, 0x3F>();
+    return RLA<0x3F>();
+  // SRE (LSR + EOR)
+  case 0x43:
+    fetchOperand<FETCH, 0x43>();
+    return SRE<0x43>();
+  case 0x47:
+    fetchOperand<FETCH, 0x47>();
+    return SRE<0x47>();
+  case 0x4F:
+    fetchOperand<FETCH, 0x4F>();
+    return SRE<0x4F>();
+  case 0x53:
+    fetchOperand<FETCH, 0x53>();
+    return SRE<0x53>();
+  case 0x57:
+    fetchOperand<FETCH, 0x57>();
+    return SRE<0x57>();
+  case 0x5B:
+    fetchOperand<FETCH, 0x5B>();
+    return SRE<0x5B>();
+  case 0x5F:
+    fetchOperand<FETCH, 0x5F>();
+    return SRE<0x5F>();
+  // RRA (ROR + ADC)
+  case 0x63:
+    fetchOperand<FETCH, 0x63>();
+    return RRA<0x63>();
+  case 0x67:
+    fetchOperand<FETCH, 0x67>();
+    return RRA<0x67>();
+  case 0x6F:
+    fetchOperand<FETCH, 0x6F>();
+    return RRA<0x6F>();
+  case 0x73:
+    fetchOperand<FETCH, 0x73>();
+    return RRA<0x73>();
+  case 0x77:
+    fetchOperand<FETCH, 0x77>();
+    return RRA<0x77>();
+  case 0x7B:
+    fetchOperand<FETCH, 0x7B>();
+    return RRA<0x7B>();
+  case 0x7F:
+    fetchOperand<FETCH, 0x7F>();
+    return RRA<0x7F>();
+  // DCP (DEC + CMP)
+  case 0xC3:
+    fetchOperand<FETCH, 0xC3>();
+    return DCP<0xC3>();
+  case 0xC7:
+    fetchOperand<FETCH, 0xC7>();
+    return DCP<0xC7>();
+  case 0xCF:
+    fetchOperand<FETCH, 0xCF>();
+    return DCP<0xCF>();
+  case 0xD3:
+    fetchOperand<FETCH, 0xD3>();
+    return DCP<0xD3>();
+  case 0xD7:
+    fetchOperand<FETCH, 0xD7>();
+    return DCP<0xD7>();
+  case 0xDB:
+    fetchOperand<FETCH, 0xDB>();
+    return DCP<0xDB>();
+  case 0xDF:
+    fetchOperand<FETCH, 0xDF>();
+    return DCP<0xDF>();
+  // ISC (INC + SBC)
+  case 0xE3:
+    fetchOperand<FETCH, 0xE3>();
+    return ISC<0xE3>();
+  case 0xE7:
+    fetchOperand<FETCH, 0xE7>();
+    return ISC<0xE7>();
+  case 0xEF:
+    fetchOperand<FETCH, 0xEF>();
+    return ISC<0xEF>();
+  case 0xF3:
+    fetchOperand<FETCH, 0xF3>();
+    return ISC<0xF3>();
+  case 0xF7:
+    fetchOperand<FETCH, 0xF7>();
+    return ISC<0xF7>();
+  case 0xFB:
+    fetchOperand<FETCH, 0xFB>();
+    return ISC<0xFB>();
+  case 0xFF:
+    fetchOperand<FETCH, 0xFF>();
+    return ISC<0xFF>();
+  // LAX (LDA + LDX)
+  case 0xA3:
+    fetchOperand<FETCH, 0xA3>();
+    return LAX<0xA3>();
+  case 0xA7:
+    fetchOperand<FETCH, 0xA7>();
+    return LAX<0xA7>();
+  case 0xAF:
+    fetchOperand<FETCH, 0xAF>();
+    return LAX<0xAF>();
+  case 0xB3:
+    fetchOperand<FETCH, 0xB3>();
+    return LAX<0xB3>();
+  case 0xB7:
+    fetchOperand<FETCH, 0xB7>();
+    return LAX<0xB7>();
+  case 0xBF:
+    fetchOperand<FETCH, 0xBF>();
+    return LAX<0xBF>();
+  // SAX (STore A AND X)
+  case 0x83:
+    fetchOperand<FETCH, 0x83>();
+    return SAX<0x83>();
+  case 0x87:
+    fetchOperand<FETCH, 0x87>();
+    return SAX<0x87>();
+  case 0x8F:
+    fetchOperand<FETCH, 0x8F>();
+    return SAX<0x8F>();
+  case 0x97:
+    fetchOperand<FETCH, 0x97>();
+    return SAX<0x97>();
+  // LAS (LDA/TSX AND SP)
+  case 0xBB:
+    fetchOperand<FETCH, 0xBB>();
+    return LAS<0xBB>();
+  // ANC (AND + carry)
+  case 0x0B:
+    fetchOperand<FETCH, 0x0B>();
+    return ANC<0x0B>();
+  case 0x2B:
+    fetchOperand<FETCH, 0x2B>();
+    return ANC<0x2B>();
+  // ALR (AND + LSR)
+  case 0x4B:
+    fetchOperand<FETCH, 0x4B>();
+    return ALR<0x4B>();
+  // ARR (AND + ROR)
+  case 0x6B:
+    fetchOperand<FETCH, 0x6B>();
+    return ARR<0x6B>();
+  // SBX (A AND X - imediato)
+  case 0xCB:
+    fetchOperand<FETCH, 0xCB>();
+    return SBX<0xCB>();
+  // XAA
+  case 0x8B:
+    fetchOperand<FETCH, 0x8B>();
+    return XAA<0x8B>();
+  // LXA
+  case 0xAB:
+    fetchOperand<FETCH, 0xAB>();
+    return LXA<0xAB>();
+  // SHA
+  case 0x93:
+    fetchOperand<FETCH, 0x93>();
+    return SHA<0x93>();
+  case 0x9F:
+    fetchOperand<FETCH, 0x9F>();
+    return SHA<0x9F>();
+  // TAS
+  case 0x9B:
+    fetchOperand<FETCH, 0x9B>();
+    return TAS<0x9B>();
+  // SHY
+  case 0x9C:
+    fetchOperand<FETCH, 0x9C>();
+    return SHY<0x9C>();
+  // SHX
+  case 0x9E:
+    fetchOperand<FETCH, 0x9E>();
+    return SHX<0x9E>();
+  // SBC (cópia não oficial de 0xE9)
+  case 0xEB:
+    fetchOperand<FETCH, 0xEB>();
+    return SBC<0xEB>();
+  // NOP (não oficiais)
+  case 0x04:
+    fetchOperand<FETCH, 0x04>();
+    return NOP<0x04>();
+  case 0x0C:
+    fetchOperand<FETCH, 0x0C>();
+    return NOP<0x0C>();
+  case 0x14:
+    fetchOperand<FETCH, 0x14>();
+    return NOP<0x14>();
+  case 0x1A:
+    fetchOperand<FETCH, 0x1A>();
+    return NOP<0x1A>();
+  case 0x1C:
+    fetchOperand<FETCH, 0x1C>();
+    return NOP<0x1C>();
+  case 0x34:
+    fetchOperand<FETCH, 0x34>();
+    return NOP<0x34>();
+  case 0x3A:
+    fetchOperand<FETCH, 0x3A>();
+    return NOP<0x3A>();
+  case 0x3C:
+    fetchOperand<FETCH, 0x3C>();
+    return NOP<0x3C>();
+  case 0x44:
+    fetchOperand<FETCH, 0x44>();
+    return NOP<0x44>();
+  case 0x54:
+    fetchOperand<FETCH, 0x54>();
+    return NOP<0x54>();
+  case 0x5A:
+    fetchOperand<FETCH, 0x5A>();
+    return NOP<0x5A>();
+  case 0x5C:
+    fetchOperand<FETCH, 0x5C>();
+    return NOP<0x5C>();
+  case 0x64:
+    fetchOperand<FETCH, 0x64>();
+    return NOP<0x64>();
+  case 0x74:
+    fetchOperand<FETCH, 0x74>();
+    return NOP<0x74>();
+  case 0x7A:
+    fetchOperand<FETCH, 0x7A>();
+    return NOP<0x7A>();
+  case 0x7C:
+    fetchOperand<FETCH, 0x7C>();
+    return NOP<0x7C>();
+  case 0x80:
+    fetchOperand<FETCH, 0x80>();
+    return NOP<0x80>();
+  case 0x82:
+    fetchOperand<FETCH, 0x82>();
+    return NOP<0x82>();
+  case 0x89:
+    fetchOperand<FETCH, 0x89>();
+    return NOP<0x89>();
+  case 0xC2:
+    fetchOperand<FETCH, 0xC2>();
+    return NOP<0xC2>();
+  case 0xD4:
+    fetchOperand<FETCH, 0xD4>();
+    return NOP<0xD4>();
+  case 0xDA:
+    fetchOperand<FETCH, 0xDA>();
+    return NOP<0xDA>();
+  case 0xDC:
+    fetchOperand<FETCH, 0xDC>();
+    return NOP<0xDC>();
+  case 0xE2:
+    fetchOperand<FETCH, 0xE2>();
+    return NOP<0xE2>();
+  case 0xF4:
+    fetchOperand<FETCH, 0xF4>();
+    return NOP<0xF4>();
+  case 0xFA:
+    fetchOperand<FETCH, 0xFA>();
+    return NOP<0xFA>();
+  case 0xFC:
+    fetchOperand<FETCH, 0xFC>();
+    return NOP<0xFC>();
+  // KIL/JAM
+  case 0x02:
+    fetchOperand<FETCH, 0x02>();
+    return JAM<0x02>();
+  case 0x12:
+    fetchOperand<FETCH, 0x12>();
+    return JAM<0x12>();
+  case 0x22:
+    fetchOperand<FETCH, 0x22>();
+    return JAM<0x22>();
+  case 0x32:
+    fetchOperand<FETCH, 0x32>();
+    return JAM<0x32>();
+  case 0x42:
+    fetchOperand<FETCH, 0x42>();
+    return JAM<0x42>();
+  case 0x52:
+    fetchOperand<FETCH, 0x52>();
+    return JAM<0x52>();
+  case 0x62:
+    fetchOperand<FETCH, 0x62>();
+    return JAM<0x62>();
+  case 0x72:
+    fetchOperand<FETCH, 0x72>();
+    return JAM<0x72>();
+  case 0x92:
+    fetchOperand<FETCH, 0x92>();
+    return JAM<0x92>();
+  case 0xB2:
+    fetchOperand<FETCH, 0xB2>();
+    return JAM<0xB2>();
+  case 0xD2:
+    fetchOperand<FETCH, 0xD2>();
+    return JAM<0xD2>();
+  case 0xF2:
+    fetchOperand<FETCH, 0xF2>();
+    return JAM<0xF2>();
+  }
+  // Todos os 256 opcodes têm um case
+  __builtin_unreachable();
+}
+
+void Cpu::enableBlockCache(bool enable) {
+  blockCacheEnabled = enable;
+  jitEnabled = jitEnabled && enable;
+  blockCache.clear();
+  blockCursor = blockEnd = nullptr;
+  memory.setPageWatcher(enable ? &blockCache : nullptr);
+}
+
+const BlockCache &Cpu::getBlockCache() { return blockCache; }
+
+void Cpu::enableJit(bool enable) {
+  enableBlockCache(enable);
+  jitEnabled = enable;
+}
+
+const Jit &Cpu::getJit() { return jit; }
+
+Profiler &Cpu::getProfiler() { return profiler; }
+
+const TraceBuffer &Cpu::getTrace() { return trace; }
+
+BlockRun Cpu::nextBlock() {
+  if (!jitEnabled) {
+    return {1, next()};
+  }
+  // next() volta a procurar o bloco a partir do novo PC
+  blockCursor = blockEnd = nullptr;
+
+  Block *block = blockCache.lookup(PC);
+  if (block->native != nullptr && block->nativeEpoch != jit.getEpoch()) {
+    // A área de código foi reciclada: o bloco volta a contar execuções
+    // para ser compilado de novo
+    block->native = nullptr;
+    block->executions = 0;
+  }
+  // Com o profiler, os blocos são interpretados para registrar cada PC
+  if (!PROFILER_ENABLED && block->native == nullptr &&
+      ++block->executions == JIT_THRESHOLD) {
+    block->native = jit.compile(*block);
+    block->nativeEpoch = jit.getEpoch();
+  }
+  BlockRun run;
+  if (block->native == nullptr) {
+    run = runBlock(*block);
+  } else {
+    // O código nativo registra cada instrução (Cpu::jitTrace)
+    uint64_t result = block->native(this);
+    run = {static_cast<uint32_t>(result >> 32),
+           static_cast<uint32_t>(result & 0xFFFFFFFF)};
+  }
+  cycles += run.cycles;
+  count += run.instructions;
+  return run;
+}
+
+// Interpreta um bloco ainda não compilado, com a mesma semântica do código
+// gerado: para assim que uma escrita invalida algum bloco
+BlockRun Cpu::runBlock(Block &block) {
+  BlockRun run{0, 0};
+  const uint64_t generation = blockCache.getGeneration();
+  const size_t size = block.ops.size();
+  for (size_t i = 0; i < size; i++) {
+    const uint16_t pc = PC;
+    // Cópia: uma escrita no próprio bloco o destrói durante execute
+    const uint8_t opcode = block.ops[i].opcode;
+    operand = block.ops[i].operand;
+    TraceRecord *record = traceInstruction(opcode, cycles + run.cycles);
+    if (TRACE_ENABLED) {
+      record->operand = operand;
+    }
+    CPUCicles executed = execute<false>(opcode);
+    if (PROFILER_ENABLED) {
+      profiler.record(pc, opcode, executed);
+    }
+    run.cycles += executed;
+    run.instructions++;
+    // Bloco possivelmente destruído: não é mais lido
+    if (generation != blockCache.getGeneration()) {
+      break;
+    }
+  }
+  return run;
+}
+
+// "flatten" inclui execute<false>(OP) no handler e reduz o switch ao case
+// do opcode
+template <uint8_t OP>
+__attribute__((flatten)) uint32_t Cpu::jitHandler(Cpu *cpu,
+                                                  uint32_t operand) {
+  cpu->operand = operand;
+  return cpu->execute<false>(OP);
+}
+
+template <int OP> struct Cpu::JitTable {
+  static void fill(JitHandler *table) {
+    table[OP] = &jitHandler<OP>;
+    JitTable<OP - 1>::fill(table);
+  }
+};
+
+template <> struct Cpu::JitTable<-1> {
+  static void fill(JitHandler *) {}
+};
+
+void Cpu::jitTrace(Cpu *cpu, uint32_t instruction, uint32_t blockCycles) {
+  TraceRecord *record =
+      cpu->traceInstruction(instruction & 0xFF, cpu->cycles + blockCycles);
+  record->operand = instruction >> 8;
+}
+
+// Tabela preenchida uma única vez (inicialização de static local é
+// thread-safe: várias CPUs podem compilar blocos ao mesmo tempo)
+struct Cpu::JitHandlerTable {
+  JitHandler handlers[0x100];
+  JitHandlerTable() { JitTable<0xFF>::fill(handlers); }
+};
+
+const Cpu::JitHandler *Cpu::jitHandlers() {
+  static const JitHandlerTable table;
+  return table.handlers;
 }
 
 void Cpu::reset() {
   memory.reset();
+  blockCache.clear();
+  blockCursor = blockEnd = nullptr;
   PC = AC = X = Y = 0x00;
-  SR = 0x30;
+  // Com um cartucho, a execução recomeça no vetor de reset
+  if (memory.isRomPage(0xFF)) {
+    PC = memory.peek(0xFFFC) | (memory.peek(0xFFFD) << 8);
+  }
+  setSR(0x30);
+  // Os eventos agendados mantêm a distância em ciclos
+  scheduler.rebase(cycles);
+  nmiPending = false;
+  count = cycles = 0;
+  jammed = false;
+  idleLoop = IdleLoop();
+  skippedInstructions = skippedCycles = 0;
+  profiler.clear();
+  trace.clear();
   SP = 0xFF;
 }
 
@@ -449,52 +1426,44 @@ MemoryAccessResult Cpu::immediate() {
 }
 
 MemoryAccessResult Cpu::zeropage() {
-  uint8_t address = memory.read(PC + 1);
+  uint8_t address = operand;
   return {address, 0x02, true};
 }
 
 MemoryAccessResult Cpu::zeropageX() {
-  uint8_t address = memory.read(PC + 1) + X;
+  uint8_t address = operand + X;
   return {address, 0x02, true};
 }
 
 MemoryAccessResult Cpu::zeropageY() {
-  uint8_t address = memory.read(PC + 1) + Y;
+  uint8_t address = operand + Y;
   return {address, 0x02, true};
 }
 MemoryAccessResult Cpu::absolute() {
-  uint8_t msb = memory.read(PC + 2);
-  uint8_t lsb = memory.read(PC + 1);
-  uint16_t address = (msb << 8) | lsb;
+  uint16_t address = operand;
 
   return {address, 0x03, true};
 }
 
 MemoryAccessResult Cpu::absoluteX() {
-  uint8_t msb = memory.read(PC + 2);
-  uint8_t lsb = memory.read(PC + 1);
-  uint16_t address = ((msb << 8) | lsb) + X;
+  uint16_t address = operand + X;
 
-  bool pageCrossed = isDifferentPage(((msb << 8) | lsb), address);
+  bool pageCrossed = isDifferentPage(operand, address);
 
   return {address, 0x03, pageCrossed};
 }
 
 MemoryAccessResult Cpu::absoluteY() {
-  uint8_t msb = memory.read(PC + 2);
-  uint8_t lsb = memory.read(PC + 1);
-  uint16_t address = ((msb << 8) | lsb) + Y;
+  uint16_t address = operand + Y;
 
-  bool pageCrossed = isDifferentPage(((msb << 8) | lsb), address);
+  bool pageCrossed = isDifferentPage(operand, address);
 
   return {address, 0x03, pageCrossed};
 }
 
 MemoryAccessResult Cpu::indirect() {
 
-  uint8_t msb_op = memory.read(PC + 2);
-  uint8_t lsb_op = memory.read(PC + 1);
-  uint16_t address_op = (msb_op << 8) | lsb_op;
+  uint16_t address_op = operand;
 
   uint8_t lsb = memory.read(address_op + 0);
   uint8_t msb = memory.read(address_op + 1);
@@ -505,7 +1474,7 @@ MemoryAccessResult Cpu::indirect() {
 }
 
 MemoryAccessResult Cpu::indirectX() {
-  uint8_t zpAddress = memory.read(PC + 1) + X;
+  uint8_t zpAddress = operand + X;
   uint8_t msb = memory.read(zpAddress + 1);
   uint8_t lsb = memory.read(zpAddress);
   uint16_t address = (msb << 8) | lsb;
@@ -514,7 +1483,7 @@ MemoryAccessResult Cpu::indirectX() {
 }
 
 MemoryAccessResult Cpu::indirectY() {
-  uint8_t zpAddress = memory.read(PC + 1);
+  uint8_t zpAddress = operand;
   uint8_t msb = memory.read(zpAddress + 1);
   uint8_t lsb = memory.read(zpAddress + 0);
   uint16_t address = ((msb << 8) | lsb) + Y;
@@ -525,7 +1494,7 @@ MemoryAccessResult Cpu::indirectY() {
 }
 
 MemoryAccessResult Cpu::relative() {
-  uint16_t value = memory.read(PC + 1);
+  uint16_t value = operand & 0xFF;
 
   if ((value & (0x01 << 7)) == 0) {
     uint8_t offset = value;
@@ -539,22 +1508,13 @@ MemoryAccessResult Cpu::relative() {
 }
 
 // -- verificadores de flags
+// Apenas registram o valor; o bit é montado em getSR()/chkFlag()
 // Negative
-void Cpu::flagActivationN(uint8_t value) {
-  if (value & (0x01 << 7)) {
-    setFlag(Flag::N);
-    return;
-  }
-  remFlag(Flag::N);
-}
+void Cpu::flagActivationN(uint8_t value) { nResult = value; }
 
 // Overflow
 void Cpu::flagActivationV(uint8_t value_orig, uint8_t value_new) {
-  if (((AC ^ value_orig) & (0x01 << 7)) && ((AC ^ value_new) & (0x01 << 7))) {
-    setFlag(Flag::V);
-    return;
-  }
-  remFlag(Flag::V);
+  overflowFlag = (((AC ^ value_orig) & (AC ^ value_new)) >> 7) & 0x01;
 }
 
 // Break
@@ -567,50 +1527,40 @@ void Cpu::flagActivationD() {}
 void Cpu::flagActivationI() {}
 
 // Zero
-void Cpu::flagActivationZ(uint8_t value) {
-  if (value == 0) {
-    setFlag(Flag::Z);
-    return;
-  }
-  remFlag(Flag::Z);
-}
+void Cpu::flagActivationZ(uint8_t value) { zResult = value; }
 
 // Carry (sum)
-void Cpu::flagActivationC_ovflw(uint16_t value) {
-  if (value > 0xFF) {
-    setFlag(Flag::C);
-    return;
-  }
-  remFlag(Flag::C);
-}
+void Cpu::flagActivationC_ovflw(uint16_t value) { carryFlag = value > 0xFF; }
 
 void Cpu::flagActivationC_unflw(uint16_t value_1, uint16_t value_2) {
-  if (value_2 < value_1) {
-    setFlag(Flag::C);
-    return;
-  }
-  remFlag(Flag::C);
+  carryFlag = value_2 < value_1;
 }
 
 // Carry (subtraction)
 // Este flag é definido se não houver empréstimo durante a subtração.
+// value_1 é sempre um registrador (8 bits): a diferença é zero só na igualdade
 void Cpu::flagActivationCMP(uint16_t value_1, uint8_t value_2) {
-  if (value_1 == value_2) {
-    setFlag(Flag::Z);
-  } else {
-    remFlag(Flag::Z);
-  }
+  zResult = value_1 - value_2;
+  nResult = value_1 - value_2;
+  carryFlag = value_1 >= value_2;
+}
 
-  flagActivationN(value_1 - value_2);
+// Soma binária com carry: C e V seguem o 6502 (subtração = soma de ~value)
+void Cpu::addWithCarry(uint8_t value) {
+  uint16_t sum = AC + value + (chkFlag(Flag::C) ? 0x01 : 0x00);
+  uint8_t result = sum;
+  flagActivationC_ovflw(sum);
+  flagActivationV(~value, result);
+  flagActivationN(result);
+  flagActivationZ(result);
+  AC = result;
+}
 
-  if (value_1 >= value_2) {
-    setFlag(Flag::C);
-  } else {
-    remFlag(Flag::C);
-  }
+uint8_t Cpu::storeMask(uint16_t address, uint8_t index) {
+  return ((address - index) >> 8) + 1;
 }
 
-MemoryAccessResult Cpu::getValueAddrMode(ADDR_MODE mode) {
+template <ADDR_MODE mode> MemoryAccessResult Cpu::getValueAddrMode() {
   switch (mode) {
   case ADDR_MODE::IMMEDIATE:
     return immediate();
@@ -651,11 +1601,20 @@ MemoryAccessResult Cpu::getValueAddrMode(ADDR_MODE mode) {
   return MemoryAccessResult{};
 }
 
+template <ADDR_MODE mode>
+uint8_t Cpu::readValue(const MemoryAccessResult &response) {
+  if (mode == ADDR_MODE::IMMEDIATE) {
+    return static_cast<uint8_t>(operand);
+  }
+  return memory.read(response.address);
+}
+
 // Implementações das instruções
 // ADC (ADd with Carry)
-Cpu::CPUCicles Cpu::ADC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::ADC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t carry = chkFlag(Flag::C) ? 0x01 : 0x00;
   uint8_t result = AC + value + carry;
   flagActivationC_ovflw(AC + value + carry);
@@ -668,9 +1627,10 @@ Cpu::CPUCicles Cpu::ADC(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // AND (bitwise AND with accumulator)
-Cpu::CPUCicles Cpu::AND(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::AND() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = value & AC;
   flagActivationN(result);
   flagActivationZ(result);
@@ -680,9 +1640,10 @@ Cpu::CPUCicles Cpu::AND(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // ASL (Arithmetic Shift Left)
-Cpu::CPUCicles Cpu::ASL(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::ASL() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = value << 0x01;
 
   (value & (0x01 << 7)) ? setFlag(Flag::C) : remFlag(Flag::C);
@@ -694,7 +1655,8 @@ Cpu::CPUCicles Cpu::ASL(const opcodeParams &params) {
   return (params.cycles);
 }
 // ASL (Arithmetic Shift Left) - Operações diretas no acumulador
-Cpu::CPUCicles Cpu::ASL_AC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::ASL_AC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   uint8_t value = AC;
   uint8_t result = (AC << 0x01);
 
@@ -707,34 +1669,24 @@ Cpu::CPUCicles Cpu::ASL_AC(const opcodeParams &params) {
   return (params.cycles);
 }
 // BIT (test BITs)
-Cpu::CPUCicles Cpu::BIT(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BIT() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = (AC & value);
 
-  if ((result & (0x01 << 7))) {
-    setFlag(Flag::N);
-  } else {
-    remFlag(Flag::N);
-  }
-  if ((result & (0x01 << 6))) {
-    setFlag(Flag::V);
-  } else {
-    remFlag(Flag::V);
-  }
-  if (result == 0x00) {
-    setFlag(Flag::Z);
-  } else {
-    remFlag(Flag::Z);
-  }
+  flagActivationN(result);
+  flagActivationZ(result);
+  overflowFlag = (result >> 6) & 0x01;
 
   incrementPC(response.size);
   return (params.cycles);
 }
 // Branch Instructions
 // - BPL (Branch on PLus) - Desvio quando FlagN = 0
-Cpu::CPUCicles Cpu::BPL(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BPL() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (!chkFlag(Flag::N)) {
     PC = response.address + response.size;
@@ -746,8 +1698,9 @@ Cpu::CPUCicles Cpu::BPL(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BMI (Branch on MInus) - Desvio quando FlagN = 1
-Cpu::CPUCicles Cpu::BMI(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BMI() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (chkFlag(Flag::N)) {
     PC = response.address + response.size;
@@ -759,8 +1712,9 @@ Cpu::CPUCicles Cpu::BMI(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BVC (Branch on oVerflow Clear) - Desvio quando FlagV = 0
-Cpu::CPUCicles Cpu::BVC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BVC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
   if (!chkFlag(Flag::V)) {
     PC = response.address + response.size;
     return (params.cycles + 0x01 +
@@ -771,8 +1725,9 @@ Cpu::CPUCicles Cpu::BVC(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BVS (Branch on oVerflow Set) - Desvio quando FlagV = 1
-Cpu::CPUCicles Cpu::BVS(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BVS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (chkFlag(Flag::V)) {
     PC = response.address + response.size;
@@ -784,8 +1739,9 @@ Cpu::CPUCicles Cpu::BVS(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BCC (Branch on Carry Clear) - Desvio quando FlagC = 0
-Cpu::CPUCicles Cpu::BCC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BCC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (!chkFlag(Flag::C)) {
     PC = response.address + response.size;
@@ -797,8 +1753,9 @@ Cpu::CPUCicles Cpu::BCC(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BCS (Branch on Carry Set) - Desvio quando FlagC = 1
-Cpu::CPUCicles Cpu::BCS(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BCS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (chkFlag(Flag::C)) {
     PC = response.address + response.size;
@@ -810,8 +1767,9 @@ Cpu::CPUCicles Cpu::BCS(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BNE (Branch on Not Equal) - Desvio quando FlagZ = 0
-Cpu::CPUCicles Cpu::BNE(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BNE() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (!chkFlag(Flag::Z)) {
     PC = response.address + response.size;
@@ -823,8 +1781,9 @@ Cpu::CPUCicles Cpu::BNE(const opcodeParams &params) {
   return (params.cycles);
 }
 // - BEQ (Branch on EQual) - Desvio quando FlagZ = 1
-Cpu::CPUCicles Cpu::BEQ(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::BEQ() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   if (chkFlag(Flag::Z)) {
     PC = response.address + response.size;
@@ -836,14 +1795,15 @@ Cpu::CPUCicles Cpu::BEQ(const opcodeParams &params) {
   return (params.cycles);
 }
 // BRK (BReaK)
-Cpu::CPUCicles Cpu::BRK(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::BRK() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   incrementPC(0x01);
   uint8_t PC_lsb = static_cast<uint8_t>(PC & 0xFF);
   uint8_t PC_msb = static_cast<uint8_t>(PC >> 8);
 
   setFlag(Flag::I);
 
-  stackPUSH(SR);
+  stackPUSH(getSR());
   stackPUSH(PC_lsb);
   stackPUSH(PC_msb);
 
@@ -856,9 +1816,10 @@ Cpu::CPUCicles Cpu::BRK(const opcodeParams &params) {
   return (params.cycles);
 }
 // CMP (CoMPare accumulator)
-Cpu::CPUCicles Cpu::CMP(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::CMP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationCMP(AC, value);
 
   incrementPC(response.size);
@@ -866,9 +1827,10 @@ Cpu::CPUCicles Cpu::CMP(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // CPX (ComPare X register)
-Cpu::CPUCicles Cpu::CPX(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::CPX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationCMP(X, value);
 
   incrementPC(response.size);
@@ -876,9 +1838,10 @@ Cpu::CPUCicles Cpu::CPX(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // CPY (ComPare Y register)
-Cpu::CPUCicles Cpu::CPY(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::CPY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationCMP(Y, value);
 
   incrementPC(response.size);
@@ -886,9 +1849,10 @@ Cpu::CPUCicles Cpu::CPY(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // DEC (DECrement memory)
-Cpu::CPUCicles Cpu::DEC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::DEC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = value - 0x01;
   flagActivationN(result);
   flagActivationZ(result);
@@ -899,9 +1863,10 @@ Cpu::CPUCicles Cpu::DEC(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // EOR (bitwise Exclusive OR)
-Cpu::CPUCicles Cpu::EOR(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::EOR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = AC ^ value;
   flagActivationN(result);
   flagActivationZ(result);
@@ -913,51 +1878,59 @@ Cpu::CPUCicles Cpu::EOR(const opcodeParams &params) {
 }
 // Flag (Processor Status) Instructions
 /// - CLC (CLear Carry)
-Cpu::CPUCicles Cpu::CLC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::CLC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   remFlag(Flag::C);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - SEC (SEt Carry)
-Cpu::CPUCicles Cpu::SEC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::SEC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   setFlag(Flag::C);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - CLI (CLear Interrupt)
-Cpu::CPUCicles Cpu::CLI(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::CLI() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   remFlag(Flag::I);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - SEI (SEt Interrupt)
-Cpu::CPUCicles Cpu::SEI(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::SEI() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   setFlag(Flag::I);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - CLV (CLear oVerflow)
-Cpu::CPUCicles Cpu::CLV(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::CLV() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   remFlag(Flag::V);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - CLD (CLear Decimal)
-Cpu::CPUCicles Cpu::CLD(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::CLD() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   remFlag(Flag::D);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - SED (SEt Decimal)
-Cpu::CPUCicles Cpu::SED(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::SED() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   setFlag(Flag::D);
   incrementPC(0x01);
   return (params.cycles);
 }
 // INC (INCrement memory)
-Cpu::CPUCicles Cpu::INC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::INC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = value + 0x01;
   flagActivationN(result);
   flagActivationZ(result);
@@ -967,15 +1940,17 @@ Cpu::CPUCicles Cpu::INC(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // JMP (JuMP)  [ok]Teste 1
-Cpu::CPUCicles Cpu::JMP(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::JMP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
   PC = response.address;
   return (params.cycles +
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // JSR (Jump to SubRoutine) - Salva o end. de Retorno na pilha
-Cpu::CPUCicles Cpu::JSR(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::JSR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
 
   uint16_t nextOP = PC + response.size;
   uint8_t nextOP_lsb = static_cast<uint8_t>(nextOP & 0x00FF);
@@ -990,9 +1965,10 @@ Cpu::CPUCicles Cpu::JSR(const opcodeParams &params) {
 }
 
 // LDA (LoaD Accumulator)
-Cpu::CPUCicles Cpu::LDA(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::LDA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationN(value);
   flagActivationZ(value);
   AC = value;
@@ -1001,9 +1977,10 @@ Cpu::CPUCicles Cpu::LDA(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // LDX (LoaD X register)ADC #$0F
-Cpu::CPUCicles Cpu::LDX(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::LDX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationN(value);
   flagActivationZ(value);
   X = value;
@@ -1012,9 +1989,10 @@ Cpu::CPUCicles Cpu::LDX(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // LDY (LoaD Y register)
-Cpu::CPUCicles Cpu::LDY(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::LDY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   flagActivationN(value);
   flagActivationZ(value);
   Y = value;
@@ -1023,9 +2001,10 @@ Cpu::CPUCicles Cpu::LDY(const opcodeParams &params) {
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // LSR (Logical Shift Right)
-Cpu::CPUCicles Cpu::LSR(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::LSR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   (value & 0x01) ? setFlag(Flag::C) : remFlag(Flag::C);
   uint8_t result = (value >> 0x01);
   flagActivationN(result);
@@ -1035,7 +2014,8 @@ Cpu::CPUCicles Cpu::LSR(const opcodeParams &params) {
   return (params.cycles +
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
-Cpu::CPUCicles Cpu::LSR_AC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::LSR_AC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   (AC & 0x01) ? setFlag(Flag::C) : remFlag(Flag::C);
   uint8_t result = (AC >> 0x01);
   flagActivationN(result);
@@ -1045,14 +2025,19 @@ Cpu::CPUCicles Cpu::LSR_AC(const opcodeParams &params) {
   return (params.cycles);
 }
 // NOP (No OPeration)
-Cpu::CPUCicles Cpu::NOP(const opcodeParams &params) {
-  incrementPC(0x01);
-  return (params.cycles);
+// Os NOPs não oficiais com operando apenas o pulam (sem leitura da memória)
+template <uint8_t OP> Cpu::CPUCicles Cpu::NOP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  incrementPC(operandSize(OP) + 1);
+  return (params.cycles +
+          (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // ORA (bitwise OR with Accumulator)
-Cpu::CPUCicles Cpu::ORA(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::ORA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t result = AC | value;
   flagActivationN(result);
   flagActivationZ(result);
@@ -1064,7 +2049,8 @@ Cpu::CPUCicles Cpu::ORA(const opcodeParams &params) {
 }
 // Register Instructions
 // - TAX (Transfer A to X)
-Cpu::CPUCicles Cpu::TAX(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TAX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   X = AC;
   flagActivationN(AC);
   flagActivationZ(AC);
@@ -1072,7 +2058,8 @@ Cpu::CPUCicles Cpu::TAX(const opcodeParams &params) {
   return (params.cycles);
 }
 // - TXA (Transfer X to A)
-Cpu::CPUCicles Cpu::TXA(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TXA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   AC = X;
   flagActivationN(X);
   flagActivationZ(X);
@@ -1080,7 +2067,8 @@ Cpu::CPUCicles Cpu::TXA(const opcodeParams &params) {
   return (params.cycles);
 }
 // - DEX (DEcrement X)
-Cpu::CPUCicles Cpu::DEX(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::DEX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   X -= 0x01;
   flagActivationN(X);
   flagActivationZ(X);
@@ -1088,7 +2076,8 @@ Cpu::CPUCicles Cpu::DEX(const opcodeParams &params) {
   return (params.cycles);
 }
 // - INX (INcrement X)
-Cpu::CPUCicles Cpu::INX(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::INX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   X += 0x01;
   flagActivationN(X);
   flagActivationZ(X);
@@ -1096,7 +2085,8 @@ Cpu::CPUCicles Cpu::INX(const opcodeParams &params) {
   return (params.cycles);
 }
 // - TAY (Transfer A to Y)
-Cpu::CPUCicles Cpu::TAY(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TAY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   Y = AC;
   flagActivationN(AC);
   flagActivationZ(AC);
@@ -1104,7 +2094,8 @@ Cpu::CPUCicles Cpu::TAY(const opcodeParams &params) {
   return (params.cycles);
 }
 // - TYA (Transfer Y to A)
-Cpu::CPUCicles Cpu::TYA(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TYA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   AC = Y;
   flagActivationN(Y);
   flagActivationZ(Y);
@@ -1112,7 +2103,8 @@ Cpu::CPUCicles Cpu::TYA(const opcodeParams &params) {
   return (params.cycles);
 }
 // - DEY (DEcrement Y)
-Cpu::CPUCicles Cpu::DEY(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::DEY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   Y -= 0x01;
   flagActivationN(Y);
   flagActivationZ(Y);
@@ -1120,7 +2112,8 @@ Cpu::CPUCicles Cpu::DEY(const opcodeParams &params) {
   return (params.cycles);
 }
 // - INY (INcrement Y)
-Cpu::CPUCicles Cpu::INY(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::INY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   Y += 0x01;
   flagActivationN(Y);
   flagActivationZ(Y);
@@ -1128,9 +2121,10 @@ Cpu::CPUCicles Cpu::INY(const opcodeParams &params) {
   return (params.cycles);
 }
 // ROL (ROtate Left)
-Cpu::CPUCicles Cpu::ROL(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::ROL() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
 
   uint8_t old_carry = chkFlag(Flag::C) ? 0x01 : 0x00;
   uint8_t new_carry = (value & (0x01 << 7));
@@ -1150,7 +2144,8 @@ Cpu::CPUCicles Cpu::ROL(const opcodeParams &params) {
   return (params.cycles +
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
-Cpu::CPUCicles Cpu::ROL_AC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::ROL_AC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
 
   uint8_t old_carry = chkFlag(Flag::C) ? 0x01 : 0x00;
   uint8_t new_carry = (AC & (0x01 << 7));
@@ -1170,9 +2165,10 @@ Cpu::CPUCicles Cpu::ROL_AC(const opcodeParams &params) {
   return (params.cycles);
 }
 // ROR (ROtate Right)
-Cpu::CPUCicles Cpu::ROR(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::ROR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   (value & 0x01) > 0 ? setFlag(Flag::C) : remFlag(Flag::C);
 
   uint8_t old_carry = chkFlag(Flag::C) ? 0x01 : 0x00;
@@ -1192,7 +2188,8 @@ Cpu::CPUCicles Cpu::ROR(const opcodeParams &params) {
   incrementPC(response.size);
   return (params.cycles);
 }
-Cpu::CPUCicles Cpu::ROR_AC(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::ROR_AC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   (AC & 0x01) > 0 ? setFlag(Flag::C) : remFlag(Flag::C);
 
   uint8_t old_carry = chkFlag(Flag::C) ? 0x01 : 0x00;
@@ -1213,17 +2210,19 @@ Cpu::CPUCicles Cpu::ROR_AC(const opcodeParams &params) {
   return (params.cycles);
 }
 // RTI (ReTurn from Interrupt)
-Cpu::CPUCicles Cpu::RTI(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::RTI() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   /*static_cast<void>(Addressingmode);*/
   uint8_t PC_msb = stackPOP();
   uint8_t PC_lsb = stackPOP();
 
-  SR = stackPOP();
+  setSR(stackPOP());
   PC = (PC_msb << 8) | PC_lsb;
   return (params.cycles);
 }
 // RTS (ReTurn from Subroutine)
-Cpu::CPUCicles Cpu::RTS(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::RTS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   uint8_t address_msb = stackPOP();
   uint8_t address_lsb = stackPOP();
   uint16_t address = (address_msb << 0x08) | address_lsb;
@@ -1231,9 +2230,10 @@ Cpu::CPUCicles Cpu::RTS(const opcodeParams &params) {
   return (params.cycles + params.cyclesOnPageCross);
 }
 // SBC (SuBtract with Carry)
-Cpu::CPUCicles Cpu::SBC(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
-  uint8_t value = memory.read(response.address);
+template <uint8_t OP> Cpu::CPUCicles Cpu::SBC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
   uint8_t carry = chkFlag(Flag::C) ? 0x01 : 0x00;
 
   uint16_t result = AC - value - (1 - carry);
@@ -1249,8 +2249,9 @@ Cpu::CPUCicles Cpu::SBC(const opcodeParams &params) {
 }
 
 // STA (STore Accumulator)
-Cpu::CPUCicles Cpu::STA(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::STA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
   memory.write(response.address, AC);
   incrementPC(response.size);
   return (params.cycles +
@@ -1258,54 +2259,275 @@ Cpu::CPUCicles Cpu::STA(const opcodeParams &params) {
 }
 // Stack Instructions
 // - TXS (Transfer X to Stack ptr)
-Cpu::CPUCicles Cpu::TXS(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TXS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   SP = X;
   incrementPC(0x01);
   return (params.cycles);
 }
 // - TSX (Transfer Stack ptr to X)
-Cpu::CPUCicles Cpu::TSX(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::TSX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   X = SP;
   incrementPC(0x01);
   return (params.cycles);
 }
 // - PHA (PusH Accumulator)
-Cpu::CPUCicles Cpu::PHA(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::PHA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   stackPUSH(AC);
   incrementPC(0x01);
   return (params.cycles);
 }
 // - PLA (PuLl Accumulator)
-Cpu::CPUCicles Cpu::PLA(const opcodeParams &params) {
+template <uint8_t OP> Cpu::CPUCicles Cpu::PLA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
   AC = stackPOP();
   incrementPC(0x01);
   return (params.cycles);
 }
 // - PHP (PusH Processor status)
-Cpu::CPUCicles Cpu::PHP(const opcodeParams &params) {
-  stackPUSH(SR);
+template <uint8_t OP> Cpu::CPUCicles Cpu::PHP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  stackPUSH(getSR());
   incrementPC(0x01);
   return (params.cycles);
 }
 // - PLP (PuLl Processor status)
-Cpu::CPUCicles Cpu::PLP(const opcodeParams &params) {
-  SR = stackPOP();
+template <uint8_t OP> Cpu::CPUCicles Cpu::PLP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  setSR(stackPOP());
   incrementPC(0x01);
   return (params.cycles);
 }
 // STX (STore X register)
-Cpu::CPUCicles Cpu::STX(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::STX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
   memory.write(response.address, X);
   incrementPC(response.size);
   return (params.cycles +
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
 // STY (STore Y register)
-Cpu::CPUCicles Cpu::STY(const opcodeParams &params) {
-  auto response = getValueAddrMode(params.addrMode);
+template <uint8_t OP> Cpu::CPUCicles Cpu::STY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
   memory.write(response.address, Y);
   incrementPC(response.size);
   return (params.cycles +
           (response.pageCrossed ? params.cyclesOnPageCross : 0));
 }
+
+// Opcodes não oficiais
+// SLO (ASL + ORA)
+template <uint8_t OP> Cpu::CPUCicles Cpu::SLO() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  uint8_t result = value << 0x01;
+  carryFlag = value >> 7;
+  memory.write(response.address, result);
+  AC |= result;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// RLA (ROL + AND)
+template <uint8_t OP> Cpu::CPUCicles Cpu::RLA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  uint8_t result = (value << 0x01) | carryFlag;
+  carryFlag = value >> 7;
+  memory.write(response.address, result);
+  AC &= result;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// SRE (LSR + EOR)
+template <uint8_t OP> Cpu::CPUCicles Cpu::SRE() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  uint8_t result = value >> 0x01;
+  carryFlag = value & 0x01;
+  memory.write(response.address, result);
+  AC ^= result;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// RRA (ROR + ADC)
+template <uint8_t OP> Cpu::CPUCicles Cpu::RRA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  uint8_t result = (value >> 0x01) | (carryFlag << 7);
+  carryFlag = value & 0x01;
+  memory.write(response.address, result);
+  addWithCarry(result);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// DCP (DEC + CMP)
+template <uint8_t OP> Cpu::CPUCicles Cpu::DCP() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t result = readValue<params.addrMode>(response) - 0x01;
+  memory.write(response.address, result);
+  flagActivationCMP(AC, result);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// ISC (INC + SBC)
+template <uint8_t OP> Cpu::CPUCicles Cpu::ISC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t result = readValue<params.addrMode>(response) + 0x01;
+  memory.write(response.address, result);
+  addWithCarry(~result);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// LAX (LDA + LDX)
+template <uint8_t OP> Cpu::CPUCicles Cpu::LAX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  AC = X = value;
+  flagActivationN(value);
+  flagActivationZ(value);
+  incrementPC(response.size);
+  return (params.cycles +
+          (response.pageCrossed ? params.cyclesOnPageCross : 0));
+}
+// SAX (STore A AND X)
+template <uint8_t OP> Cpu::CPUCicles Cpu::SAX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  memory.write(response.address, AC & X);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// LAS (memória AND SP em A, X e SP)
+template <uint8_t OP> Cpu::CPUCicles Cpu::LAS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response) & SP;
+  AC = X = SP = value;
+  flagActivationN(value);
+  flagActivationZ(value);
+  incrementPC(response.size);
+  return (params.cycles +
+          (response.pageCrossed ? params.cyclesOnPageCross : 0));
+}
+// ANC (AND com o bit 7 copiado para o carry)
+template <uint8_t OP> Cpu::CPUCicles Cpu::ANC() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  AC &= readValue<params.addrMode>(response);
+  carryFlag = AC >> 7;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// ALR (AND + LSR A)
+template <uint8_t OP> Cpu::CPUCicles Cpu::ALR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = AC & readValue<params.addrMode>(response);
+  carryFlag = value & 0x01;
+  AC = value >> 0x01;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// ARR (AND + ROR A; C = bit 6 e V = bit 6 XOR bit 5 do resultado)
+template <uint8_t OP> Cpu::CPUCicles Cpu::ARR() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = AC & readValue<params.addrMode>(response);
+  AC = (value >> 0x01) | (carryFlag << 7);
+  carryFlag = (AC >> 6) & 0x01;
+  overflowFlag = ((AC >> 6) ^ (AC >> 5)) & 0x01;
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// SBX (X = (A AND X) - memória, com flags do CMP)
+template <uint8_t OP> Cpu::CPUCicles Cpu::SBX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  uint8_t value = readValue<params.addrMode>(response);
+  flagActivationCMP(AC & X, value);
+  X = (AC & X) - value;
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// XAA (instável: A = (A OR 0xEE) AND X AND memória)
+template <uint8_t OP> Cpu::CPUCicles Cpu::XAA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  AC = (AC | 0xEE) & X & readValue<params.addrMode>(response);
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// LXA (instável: A = X = (A OR 0xEE) AND memória)
+template <uint8_t OP> Cpu::CPUCicles Cpu::LXA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  AC = X = (AC | 0xEE) & readValue<params.addrMode>(response);
+  flagActivationN(AC);
+  flagActivationZ(AC);
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// SHA (instável: grava A AND X AND (byte alto + 1))
+template <uint8_t OP> Cpu::CPUCicles Cpu::SHA() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  memory.write(response.address, AC & X & storeMask(response.address, Y));
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// TAS (instável: SP = A AND X; grava SP AND (byte alto + 1))
+template <uint8_t OP> Cpu::CPUCicles Cpu::TAS() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  SP = AC & X;
+  memory.write(response.address, SP & storeMask(response.address, Y));
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// SHY (instável: grava Y AND (byte alto + 1))
+template <uint8_t OP> Cpu::CPUCicles Cpu::SHY() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  memory.write(response.address, Y & storeMask(response.address, X));
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// SHX (instável: grava X AND (byte alto + 1))
+template <uint8_t OP> Cpu::CPUCicles Cpu::SHX() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  auto response = getValueAddrMode<params.addrMode>();
+  memory.write(response.address, X & storeMask(response.address, Y));
+  incrementPC(response.size);
+  return (params.cycles);
+}
+// KIL/JAM: a CPU para no mesmo PC até o reset
+template <uint8_t OP> Cpu::CPUCicles Cpu::JAM() {
+  constexpr opcodeParams params = opcodeInfo[OP];
+  jammed = true;
+  return (params.cycles);
+}
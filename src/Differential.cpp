@@ -0,0 +1,95 @@
+#include "Differential.hpp"
+#include <initializer_list>
+#include <iomanip>
+
+DifferentialRunner::DifferentialRunner(std::string path, uint16_t address,
+                                       uint32_t seed)
+    : jitCpu(jitMemory), referenceCpu(referenceMemory) {
+  for (Memory *memory : {&jitMemory, &referenceMemory}) {
+    memory->setRandomSeed(seed);
+    memory->enableSaveStatusToFile(false);
+    memory->fillZeroData();
+    memory->loadMemoryFromFile(path, address);
+  }
+  jitCpu.setAsmAddress(address);
+  referenceCpu.setAsmAddress(address);
+  jitCpu.enableJit(true);
+}
+
+DifferentialRunner::~DifferentialRunner() {}
+
+bool DifferentialRunner::run(uint64_t count) {
+  for (uint64_t i = 0; i < count; i++) {
+    const uint16_t start = jitCpu.getPC();
+    BlockRun run = jitCpu.nextBlock();
+
+    uint32_t referenceCycles = 0;
+    for (uint32_t j = 0; j < run.instructions; j++) {
+      referenceCycles += referenceCpu.next();
+    }
+
+    blocks++;
+    instructions += run.instructions;
+
+    Divergence divergence{blocks,
+                          start,
+                          jitCpu.getState(),
+                          referenceCpu.getState(),
+                          run.cycles,
+                          referenceCycles,
+                          -1,
+                          0,
+                          0};
+    divergence.address = jitMemory.firstDifference(referenceMemory);
+    if (divergence.address >= 0) {
+      divergence.jitValue = jitMemory.peek(divergence.address);
+      divergence.referenceValue = referenceMemory.peek(divergence.address);
+    }
+
+    if (divergence.jit != divergence.reference ||
+        run.cycles != referenceCycles || divergence.address >= 0) {
+      divergences.push_back(divergence);
+      return false;
+    }
+  }
+  return true;
+}
+
+const std::vector<Divergence> &DifferentialRunner::getDivergences() {
+  return divergences;
+}
+
+uint64_t DifferentialRunner::getBlocks() { return blocks; }
+
+uint64_t DifferentialRunner::getInstructions() { return instructions; }
+
+void DifferentialRunner::report(std::ostream &out) {
+  out << std::dec << "| Blocks: " << blocks << " | Instructions: "
+      << instructions << " | Compiled: "
+      << jitCpu.getJit().getCompiledBlocks() << "\n";
+  if (divergences.empty()) {
+    out << "| No divergences\n";
+    return;
+  }
+
+  for (const Divergence &d : divergences) {
+    out << "| Divergence in block " << std::dec << d.block << " ($"
+        << std::hex << std::setfill('0') << std::setw(4) << d.blockStart
+        << ")\n";
+    for (int side = 0; side < 2; side++) {
+      const CpuState &s = side == 0 ? d.jit : d.reference;
+      out << (side == 0 ? "|   jit: " : "|   ref: ") << std::hex
+          << std::setfill('0') << "PC: " << std::setw(4) << (int)s.PC
+          << " SP: " << std::setw(2) << (int)s.SP << " AC: " << std::setw(2)
+          << (int)s.AC << " X: " << std::setw(2) << (int)s.X
+          << " Y: " << std::setw(2) << (int)s.Y << " SR: " << std::setw(2)
+          << (int)s.SR << " cycles: " << std::dec
+          << (side == 0 ? d.jitCycles : d.referenceCycles) << "\n";
+    }
+    if (d.address >= 0) {
+      out << "|   memory $" << std::hex << std::setfill('0') << std::setw(4)
+          << d.address << ": jit " << std::setw(2) << (int)d.jitValue
+          << " ref " << std::setw(2) << (int)d.referenceValue << "\n";
+    }
+  }
+}
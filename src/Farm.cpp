@@ -0,0 +1,141 @@
+#include "Farm.hpp"
+#include <algorithm>
+#include <deque>
+#include <thread>
+
+// Fila de jobs, thread e instância de um worker
+struct Farm::Worker {
+  std::deque<size_t> queue;
+  std::mutex mutex;
+  std::thread thread;
+};
+
+Farm::Farm(size_t count) {
+  if (count == 0) {
+    count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < count; i++) {
+    workers.emplace_back(new Worker());
+  }
+  for (size_t i = 0; i < count; i++) {
+    workers[i]->thread = std::thread(&Farm::workerLoop, this, i);
+  }
+}
+
+Farm::~Farm() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  started.notify_all();
+  for (auto &worker : workers) {
+    worker->thread.join();
+  }
+}
+
+size_t Farm::getWorkers() const { return workers.size(); }
+
+uint64_t Farm::getSteals() const { return steals; }
+
+std::vector<FarmResult> Farm::run(const std::vector<FarmJob> &batchJobs,
+                                  Inspector batchInspect) {
+  std::vector<FarmResult> batchResults(batchJobs.size());
+  if (batchJobs.empty()) {
+    return batchResults;
+  }
+
+  // Os workers só leem estes campos depois de retirar um job de uma fila
+  // (o mutex da fila ordena as escritas)
+  jobs = &batchJobs;
+  results = &batchResults;
+  inspect = batchInspect;
+  pending = batchJobs.size();
+
+  // Faixas contíguas por worker; o roubo equilibra jobs de durações
+  // diferentes
+  const size_t count = workers.size();
+  for (size_t i = 0; i < count; i++) {
+    std::lock_guard<std::mutex> lock(workers[i]->mutex);
+    for (size_t job = batchJobs.size() * i / count;
+         job < batchJobs.size() * (i + 1) / count; job++) {
+      workers[i]->queue.push_back(job);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  batch++;
+  started.notify_all();
+  finished.wait(lock, [this]() { return pending == 0; });
+  return batchResults;
+}
+
+// A própria fila é consumida pelo fim; as dos outros, pelo início
+bool Farm::takeJob(size_t index, size_t &job) {
+  {
+    Worker &own = *workers[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.queue.empty()) {
+      job = own.queue.back();
+      own.queue.pop_back();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers.size(); i++) {
+    Worker &victim = *workers[(index + i) % workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.queue.empty()) {
+      job = victim.queue.front();
+      victim.queue.pop_front();
+      steals++;
+      return true;
+    }
+  }
+  return false;
+}
+
+void Farm::workerLoop(size_t index) {
+  // Instância do worker (alocada na própria thread)
+  std::unique_ptr<Memory> memory(new Memory());
+  std::unique_ptr<Cpu> cpu(new Cpu(*memory));
+  memory->enableSaveStatusToFile(false);
+
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      started.wait(lock, [&]() { return stopping || batch != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = batch;
+    }
+
+    size_t job;
+    while (takeJob(index, job)) {
+      (*results)[job] = runJob(*cpu, *memory, (*jobs)[job]);
+      if (inspect) {
+        inspect(job, *cpu, *memory);
+      }
+      if (--pending == 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.notify_all();
+      }
+    }
+  }
+}
+
+FarmResult Farm::runJob(Cpu &cpu, Memory &memory, const FarmJob &job) {
+  static const std::vector<uint8_t> empty;
+  memory.setRandomSeed(job.seed);
+  memory.loadProgram(job.program ? *job.program : empty, job.address);
+  cpu.enableJit(job.jit);
+  cpu.reset();
+  cpu.setAsmAddress(job.address);
+
+  FarmResult result;
+  result.summary = job.cycles > 0 ? cpu.runCycles(job.cycles)
+                                  : cpu.runInstructions(job.instructions);
+  result.state = cpu.getState();
+  result.memoryHash = memory.hash();
+  return result;
+}
@@ -12,9 +12,13 @@
 #include <sstream>
 #include <string>
 
-Gui::Gui(Cpu &cpu) : cpu(cpu) {
+Gui::Gui(Cpu &cpu)
+    : cpu(cpu), rewind(cpu, cpu.getMemory()),
+      dirtyConsumer(cpu.getMemory().addDirtyConsumer()) {
   // Program screen
-  window = new sf::RenderWindow(sf::VideoMode(1170, 660), "byteNES");
+  // Com o profiler, a janela ganha o painel de endereços mais executados
+  window = new sf::RenderWindow(
+      sf::VideoMode(PROFILER_ENABLED ? 1420 : 1170, 660), "byteNES");
   window->setVerticalSyncEnabled(true);
 
   gameScreen = new sf::RectangleShape(sf::Vector2f(256, 256));
@@ -171,6 +175,27 @@ Gui::Gui(Cpu &cpu) : cpu(cpu) {
   zeroPageDataText->setPosition(635, 90);
   zeroPageDataText->setLineSpacing(1.5);
 
+  // Profiler monitor
+  profilerScreenTitle = new sf::Text();
+  profilerScreenTitle->setFont(*font);
+  profilerScreenTitle->setFillColor(sf::Color::White);
+  profilerScreenTitle->setString("HOT PC  (P)rofile");
+  profilerScreenTitle->setCharacterSize(20);
+  profilerScreenTitle->setPosition(1150, 15);
+
+  profilerScreen = new sf::RectangleShape(sf::Vector2f(240, 540));
+  profilerScreen->setPosition(1150, 50);
+  profilerScreen->setFillColor(sf::Color(20, 20, 20));
+  profilerScreen->setOutlineColor(sf::Color(80, 80, 80));
+  profilerScreen->setOutlineThickness(1);
+
+  profilerDataText = new sf::Text();
+  profilerDataText->setFont(*font);
+  profilerDataText->setFillColor(sf::Color::Green);
+  profilerDataText->setCharacterSize(20);
+  profilerDataText->setPosition(1160, 65);
+  profilerDataText->setLineSpacing(1.5);
+
   std::string keyMappingStr = "(R)eset   (N)ext instruction   R(E)sume";
   keyMappingText = new sf::Text();
   keyMappingText->setFont(*font);
@@ -225,7 +250,7 @@ Gui::Gui(Cpu &cpu) : cpu(cpu) {
   colors[0x0F] = sf::Color(128, 128, 0);
 }
 
-Gui::~Gui() {}
+Gui::~Gui() { cpu.getMemory().removeDirtyConsumer(dirtyConsumer); }
 
 void Gui::updateFlag() {
   for (size_t i = 0; i < flagsTiles.size(); i++) {
@@ -264,7 +289,7 @@ void Gui::updateZeroPageMemory() {
   zeroPageDataStr = "";
 
   for (size_t i = 1; i <= 256; i++) {
-    zeroPageDataStr += intTohexU8(cpu.getMemory().read(i - 1)) + " ";
+    zeroPageDataStr += intTohexU8(cpu.getMemory().peek(i - 1)) + " ";
     if (i % 16 == 0) {
       zeroPageDataStr += "\n";
     }
@@ -272,6 +297,23 @@ void Gui::updateZeroPageMemory() {
   zeroPageDataText->setString(zeroPageDataStr);
 }
 
+void Gui::updateProfiler() {
+  std::stringstream ss;
+  ss << "PC   OP     COUNT\n";
+  for (const ProfileEntry &entry :
+       cpu.getProfiler().topAddresses(PROFILER_TOP)) {
+    ss << intTohexU16(entry.pc) << " " << intTohexU8(entry.opcode) << " "
+       << std::dec << std::setfill(' ') << std::setw(9) << entry.count
+       << "\n";
+  }
+  profilerDataText->setString(ss.str());
+}
+
+void Gui::exportProfile() {
+  cpu.getProfiler().exportToFile("memory_status/profile.csv");
+  cpu.getProfiler().exportToFile("memory_status/profile.json");
+}
+
 void Gui::updateCpuCount() {
   std::stringstream ss;
   ss << "COUNT: " << cpu.getCount();
@@ -279,7 +321,15 @@ void Gui::updateCpuCount() {
   gameScreenCount->setString(ss.str());
 }
 
+void Gui::updateRewind(size_t frames) {
+  std::stringstream ss;
+  ss << "REWIND: " << frames;
+
+  gameScreenCount->setString(ss.str());
+}
+
 void Gui::show() {
+  rewind.push();
 
   while (window->isOpen()) {
     sf::Event event;
@@ -291,6 +341,7 @@ void Gui::show() {
         buttonsLock[0] = true;
         buttonsPress[0]->setFillColor(sf::Color::Blue);
         cpu.reset();
+        rewind.push();
 
       } else if (!sf::Keyboard::isKeyPressed(sf::Keyboard::R) &&
                  buttonsLock[0]) {
@@ -302,6 +353,7 @@ void Gui::show() {
         buttonsLock[1] = true;
         buttonsPress[1]->setFillColor(sf::Color::Blue);
         cpu.next();
+        rewind.push();
       } else if (!sf::Keyboard::isKeyPressed(sf::Keyboard::N) &&
                  buttonsLock[1]) {
         buttonsLock[1] = false;
@@ -340,6 +392,16 @@ void Gui::show() {
         buttonsLock[4] = false;
       }
 
+      if (event.type == sf::Event::KeyPressed &&
+          event.key.code == sf::Keyboard::T) {
+        cpu.getTrace().dumpToFile("memory_status/trace.log");
+      }
+
+      if (PROFILER_ENABLED && event.type == sf::Event::KeyPressed &&
+          event.key.code == sf::Keyboard::P) {
+        exportProfile();
+      }
+
       if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
         cpu.getMemory().write(0xFF, 0x77);
       }
@@ -360,12 +422,32 @@ void Gui::show() {
     window->draw(*gameScreenCount);
     window->draw(*gameScreen);
 
+    // Segurando a seta para a esquerda, volta um quadro por iteração (o
+    // contador mostra os quadros restantes)
+    const bool rewinding = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+    if (rewinding) {
+      rewind.rewind();
+    }
+
+    // Painéis de memória só são refeitos quando a região foi escrita
+    const DirtyRegions dirty = cpu.getMemory().consumeDirty(dirtyConsumer);
+    // Espelhos do arquivo de status (sem arquivo não faz nada)
+    cpu.getMemory().saveMemoryStatusToFile();
     updateFlag();
     updateRegisters();
-    updateZeroPageMemory();
-    updateCpuCount();
+    if (dirty.isPageDirty(0x00)) {
+      updateZeroPageMemory();
+    }
+    if (rewinding) {
+      updateRewind(rewind.getFrames());
+    } else {
+      updateCpuCount();
+    }
+    if (PROFILER_ENABLED) {
+      updateProfiler();
+    }
 
-    loadFrameInMemory(0x0200);
+    loadFrameInMemory(0x0200, dirty);
 
     window->draw(*flagsBar);
     for (auto &flag : flagsTiles) {
@@ -388,6 +470,12 @@ void Gui::show() {
 
     window->draw(*zeroPageDataText);
 
+    if (PROFILER_ENABLED) {
+      window->draw(*profilerScreenTitle);
+      window->draw(*profilerScreen);
+      window->draw(*profilerDataText);
+    }
+
     for (auto &button : buttonsPress) {
       window->draw(*button);
     }
@@ -401,26 +489,37 @@ void Gui::show() {
     window->display();
     flags++;
 
-    if (!isDebugMode) {
-      for (int i = 0; i < 18; i++) {
-        cpu.next();
-      }
+    if (!isDebugMode && !rewinding) {
+      cpu.runInstructions(18);
+      rewind.push();
     }
   }
+
+  if (PROFILER_ENABLED) {
+    exportProfile();
+  }
 }
 
-// 256 x 240
-void Gui::loadFrameInMemory(uint16_t begin) {
-  uint16_t i = 0;
-  for (size_t y = 0; y < 32; y++) {
-    for (size_t x = 0; x < 32; x++) {
-      uint8_t value = cpu.getMemory().read(begin + i++);
+// 32 x 32 pixels a partir de "begin": só as linhas de memória alteradas
+// (2 linhas de pixels cada) são relidas e a textura é enviada uma vez
+void Gui::loadFrameInMemory(uint16_t begin, const DirtyRegions &dirty) {
+  const size_t line = DirtyRegions::LINE_SIZE;
+  bool changed = false;
+  for (size_t offset = 0; offset < 32 * 32; offset += line) {
+    if (!dirty.isRangeDirty(begin + offset, begin + offset + line - 1)) {
+      continue;
+    }
+    changed = true;
+    for (size_t i = offset; i < offset + line; i++) {
+      uint8_t value = cpu.getMemory().peek(begin + i);
 
       uint8_t index = value & 0x0F;
       sf::Color color = colors[index];
-      gameImage->setPixel(x, y, color);
-      gameTexture->loadFromImage(*gameImage);
-      gameSprite->setTexture(*gameTexture);
+      gameImage->setPixel(i % 32, i / 32, color);
     }
   }
+  if (changed) {
+    gameTexture->loadFromImage(*gameImage);
+    gameSprite->setTexture(*gameTexture);
+  }
 }
@@ -0,0 +1,137 @@
+#include "IdleLoop.hpp"
+#include "Opcodes.hpp"
+
+namespace {
+
+// Instruções que só alteram registradores/flags (sem escrita e sem pilha).
+// Os modos são implícito, imediato, zeropage ou absoluto.
+bool isPure(uint8_t opcode) {
+  switch (opcode) {
+  case 0xEA: // NOP
+  case 0x1A: case 0x3A: case 0x5A: case 0x7A: case 0xDA: case 0xFA: // *NOP
+  case 0x80: case 0x82: case 0x89: case 0xC2: case 0xE2: // *NOP #
+  case 0x04: case 0x44: case 0x64: case 0x0C: // *NOP zpg/abs
+  case 0xAA: case 0x8A: case 0xA8: case 0x98: case 0xBA: case 0x9A: // Txx
+  case 0xE8: case 0xC8: case 0xCA: case 0x88: // INX, INY, DEX, DEY
+  case 0x18: case 0x38: case 0x58: case 0x78: // CLC, SEC, CLI, SEI
+  case 0xB8: case 0xD8: case 0xF8: // CLV, CLD, SED
+  case 0x0A: case 0x2A: case 0x4A: case 0x6A: // ASL/ROL/LSR/ROR A
+  case 0xA9: case 0xA5: case 0xAD: // LDA
+  case 0xA2: case 0xA6: case 0xAE: // LDX
+  case 0xA0: case 0xA4: case 0xAC: // LDY
+  case 0xA7: case 0xAF: // *LAX
+  case 0xC9: case 0xC5: case 0xCD: // CMP
+  case 0xE0: case 0xE4: case 0xEC: // CPX
+  case 0xC0: case 0xC4: case 0xCC: // CPY
+  case 0x24: case 0x2C: // BIT
+  case 0x29: case 0x25: case 0x2D: // AND
+  case 0x09: case 0x05: case 0x0D: // ORA
+  case 0x49: case 0x45: case 0x4D: // EOR
+  case 0x69: case 0x65: case 0x6D: // ADC
+  case 0xE9: case 0xE5: case 0xED: // SBC
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Instruções puras que leem ou escrevem X
+bool usesX(uint8_t opcode) {
+  switch (opcode) {
+  case 0xAA: case 0x8A: case 0xBA: case 0x9A: // TAX, TXA, TSX, TXS
+  case 0xE8: case 0xCA: // INX, DEX
+  case 0xA2: case 0xA6: case 0xAE: // LDX
+  case 0xA7: case 0xAF: // *LAX
+  case 0xE0: case 0xE4: case 0xEC: // CPX
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Instruções puras que leem ou escrevem Y
+bool usesY(uint8_t opcode) {
+  switch (opcode) {
+  case 0xA8: case 0x98: // TAY, TYA
+  case 0xC8: case 0x88: // INY, DEY
+  case 0xA0: case 0xA4: case 0xAC: // LDY
+  case 0xC0: case 0xC4: case 0xCC: // CPY
+    return true;
+  default:
+    return false;
+  }
+}
+
+// DEX/DEY/INX/INY imediatamente antes do BNE: o laço termina quando o
+// registrador chega a zero (desde que nenhuma outra instrução o use)
+void findCounter(IdleLoop &loop, const uint8_t *opcodes, uint8_t bodySize) {
+  if (bodySize == 0) {
+    return;
+  }
+  const uint8_t last = opcodes[bodySize - 1];
+  const IdleCounter counter = (last == 0xCA || last == 0xE8)   ? IdleCounter::X
+                              : (last == 0x88 || last == 0xC8) ? IdleCounter::Y
+                                                               : IdleCounter::NONE;
+  if (counter == IdleCounter::NONE) {
+    return;
+  }
+  for (uint8_t i = 0; i + 1 < bodySize; i++) {
+    if (counter == IdleCounter::X ? usesX(opcodes[i]) : usesY(opcodes[i])) {
+      return;
+    }
+  }
+  loop.counter = counter;
+  loop.step = (last == 0xCA || last == 0x88) ? -1 : 1;
+}
+
+} // namespace
+
+IdleLoop analyzeIdleLoop(const Memory &memory, uint16_t head) {
+  IdleLoop loop;
+  loop.head = head;
+  loop.valid = true;
+
+  uint8_t opcodes[IDLE_LOOP_MAX_LENGTH];
+  uint16_t address = head;
+  for (uint8_t i = 0; i < IDLE_LOOP_MAX_LENGTH; i++) {
+    const uint8_t opcode = memory.peek(address);
+    const uint8_t size = operandSize(opcode);
+    uint16_t operand = 0;
+    if (size > 0) {
+      operand = memory.peek(address + 1);
+    }
+    if (size > 1) {
+      operand |= memory.peek(address + 2) << 8;
+    }
+
+    if (isControlFlow(opcode)) {
+      // Apenas desvios condicionais ou JMP absoluto de volta ao início
+      const bool branch = (opcode & 0x1F) == 0x10;
+      const uint16_t target =
+          branch ? address + 2 + static_cast<int8_t>(operand & 0xFF) : operand;
+      if ((branch || opcode == 0x4C) && target == head) {
+        loop.idle = true;
+        loop.length = i + 1;
+        if (opcode == 0xD0) {
+          findCounter(loop, opcodes, i);
+        }
+      }
+      return loop;
+    }
+
+    // Leituras de $FE ou de dispositivos mudam a cada iteração
+    const ADDR_MODE mode = opcodeInfo[opcode].addrMode;
+    const bool reads =
+        mode == ADDR_MODE::ZEROPAGE || mode == ADDR_MODE::ABSOLUTE;
+    const uint16_t target = mode == ADDR_MODE::ZEROPAGE ? operand & 0xFF
+                                                        : operand;
+    if (!isPure(opcode) ||
+        (reads && (memory.isRandomAddress(target) ||
+                   memory.isDevicePage(target >> 8)))) {
+      return loop;
+    }
+    opcodes[i] = opcode;
+    address += size + 1;
+  }
+  return loop;
+}
@@ -0,0 +1,22 @@
+#include "IntervalTimer.hpp"
+
+IntervalTimer::IntervalTimer(Cpu &cpu, uint64_t period)
+    : cpu(cpu), period(period > 0 ? period : 1) {}
+
+IntervalTimer::~IntervalTimer() { stop(); }
+
+void IntervalTimer::start() {
+  stop();
+  cpu.getScheduler().schedule(cpu.getCycles() + period, this);
+}
+
+void IntervalTimer::stop() { cpu.getScheduler().cancelAll(this); }
+
+uint64_t IntervalTimer::getTicks() const { return ticks; }
+
+// O próximo disparo conta a partir do ciclo agendado (sem acumular atraso)
+void IntervalTimer::onEvent(uint64_t cycle, uint32_t, Scheduler &scheduler) {
+  ticks++;
+  cpu.triggerNMI();
+  scheduler.schedule(cycle + period, this);
+}
@@ -0,0 +1,419 @@
+#include "Jit.hpp"
+#include "Cpu.hpp"
+#include "Opcodes.hpp"
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_X86_64
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+Jit::Jit(Cpu &cpu) : cpu(cpu) {}
+
+Jit::~Jit() {
+#ifdef JIT_X86_64
+  if (code != nullptr) {
+    munmap(code, CODE_CAPACITY);
+  }
+#endif
+}
+
+bool Jit::isSupported() {
+#ifdef JIT_X86_64
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint64_t Jit::getCompiledBlocks() const { return compiledBlocks; }
+
+size_t Jit::getCodeSize() const { return used; }
+
+#ifdef JIT_X86_64
+
+namespace {
+
+// Endereços das flags avaliadas sob demanda (ver Cpu::getSR)
+struct FlagBytes {
+  uint8_t *nResult;
+  uint8_t *zResult;
+  uint8_t *carryFlag;
+  uint8_t *overflowFlag;
+  uint8_t *SR;
+};
+
+// Montador mínimo: apenas as instruções usadas pelo Jit
+struct Emitter {
+  FlagBytes flags;
+  std::vector<uint8_t> bytes;
+
+  void emit(std::initializer_list<uint8_t> values) {
+    bytes.insert(bytes.end(), values);
+  }
+  void imm32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      bytes.push_back(value >> (i * 8));
+    }
+  }
+  void imm64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+      bytes.push_back(value >> (i * 8));
+    }
+  }
+
+  // movabs rax, imm64
+  void movRax(uintptr_t value) {
+    emit({0x48, 0xB8});
+    imm64(value);
+  }
+  // movabs rdx, imm64
+  void movRdx(const void *pointer) {
+    emit({0x48, 0xBA});
+    imm64(reinterpret_cast<uintptr_t>(pointer));
+  }
+  // movabs rax, &generation ; cmp [rax], r14 ; jne rel32
+  // Retorna a posição do rel32 para ser corrigida depois
+  size_t jumpIfGenerationChanged(const uint64_t *generation) {
+    movRax(reinterpret_cast<uintptr_t>(generation));
+    emit({0x4C, 0x39, 0x30});
+    emit({0x0F, 0x85});
+    imm32(0);
+    return bytes.size() - 4;
+  }
+  void patch(size_t at, size_t target) {
+    int32_t relative = static_cast<int32_t>(target - (at + 4));
+    std::memcpy(&bytes[at], &relative, sizeof(relative));
+  }
+
+  // Grava o valor em al como último resultado (N e Z) e, se "carry",
+  // r8b como C
+  void updateFlags(bool carry) {
+    movRdx(flags.nResult);
+    emit({0x88, 0x02}); // mov [rdx], al
+    movRdx(flags.zResult);
+    emit({0x88, 0x02}); // mov [rdx], al
+    if (carry) {
+      movRdx(flags.carryFlag);
+      emit({0x44, 0x88, 0x02}); // mov [rdx], r8b
+    }
+  }
+  // Copia um registrador de 8 bits para outro, atualizando N e Z
+  void transfer(const uint8_t *from, uint8_t *to) {
+    movRdx(from);
+    emit({0x8A, 0x02}); // mov al, [rdx]
+    movRdx(to);
+    emit({0x88, 0x02}); // mov [rdx], al
+    updateFlags(false);
+  }
+  // Incrementa (ou decrementa) um registrador, atualizando N e Z
+  void step(uint8_t *reg, bool increment) {
+    movRdx(reg);
+    emit({0x8A, 0x02}); // mov al, [rdx]
+    emit({0xFE, static_cast<uint8_t>(increment ? 0xC0 : 0xC8)}); // inc/dec
+    emit({0x88, 0x02}); // mov [rdx], al
+    updateFlags(false);
+  }
+  // Carrega um valor imediato, atualizando N e Z
+  void load(uint8_t *reg, uint8_t value) {
+    emit({0xB0, value}); // mov al, value
+    movRdx(reg);
+    emit({0x88, 0x02}); // mov [rdx], al
+    updateFlags(false);
+  }
+  // Compara um registrador com um valor imediato (Cpu::flagActivationCMP)
+  void compare(const uint8_t *reg, uint8_t value) {
+    movRdx(reg);
+    emit({0x8A, 0x02});             // mov al, [rdx]
+    emit({0x2C, value});            // sub al, value
+    emit({0x41, 0x0F, 0x93, 0xC0}); // setae r8b
+    updateFlags(true);
+  }
+  // Byte que guarda a flag (N, Z, C e V ficam fora de SR)
+  uint8_t *flagByte(Flag flag) {
+    switch (flag) {
+    case Flag::N:
+      return flags.nResult;
+    case Flag::Z:
+      return flags.zResult;
+    case Flag::C:
+      return flags.carryFlag;
+    case Flag::V:
+      return flags.overflowFlag;
+    default:
+      return flags.SR;
+    }
+  }
+  // CLC/SEC/CLI/SEI/CLV/CLD/SED (N e Z nunca chegam aqui)
+  void writeFlag(Flag flag, bool set) {
+    movRdx(flagByte(flag));
+    if (flag == Flag::C || flag == Flag::V) {
+      emit({0xC6, 0x02, static_cast<uint8_t>(set ? 0x01 : 0x00)}); // mov byte
+    } else if (set) {
+      emit({0x80, 0x0A, static_cast<uint8_t>(flag)}); // or byte [rdx], flag
+    } else {
+      emit({0x80, 0x22, static_cast<uint8_t>(~static_cast<uint8_t>(flag))});
+    }
+  }
+  // Desvio condicional com destino conhecido: PC e ciclos dos dois caminhos
+  void branch(Flag flag, bool whenSet, uint16_t *PC, uint16_t taken,
+              uint8_t takenCycles, uint16_t next, uint8_t nextCycles) {
+    // Flag ativa <=> bit de teste diferente de zero, exceto Z (zResult == 0)
+    uint8_t mask = flag == Flag::N ? 0x80 : flag == Flag::Z ? 0xFF : 0x01;
+    bool whenNonZero = flag == Flag::Z ? !whenSet : whenSet;
+    movRdx(flagByte(flag));
+    emit({0xF6, 0x02, mask}); // test byte [rdx], mask
+    movRdx(PC);
+    // Caminho tomado: 11 bytes (mov word + add r12d + jmp)
+    emit({static_cast<uint8_t>(whenNonZero ? 0x74 : 0x75), 0x0B}); // jz/jnz
+    emit({0x66, 0xC7, 0x02, static_cast<uint8_t>(taken),
+          static_cast<uint8_t>(taken >> 8)}); // mov word [rdx], taken
+    emit({0x41, 0x83, 0xC4, takenCycles});    // add r12d, takenCycles
+    emit({0xEB, 0x09});                       // jmp +9
+    emit({0x66, 0xC7, 0x02, static_cast<uint8_t>(next),
+          static_cast<uint8_t>(next >> 8)}); // mov word [rdx], next
+    emit({0x41, 0x83, 0xC4, nextCycles});    // add r12d, nextCycles
+  }
+};
+
+// Instruções emitidas diretamente em código nativo (sem acesso à memória)
+bool isNative(uint8_t opcode) {
+  switch (opcode) {
+  case 0xEA: // NOP
+  case 0x18: // CLC
+  case 0x38: // SEC
+  case 0x58: // CLI
+  case 0x78: // SEI
+  case 0xB8: // CLV
+  case 0xD8: // CLD
+  case 0xF8: // SED
+  case 0xAA: // TAX
+  case 0x8A: // TXA
+  case 0xA8: // TAY
+  case 0x98: // TYA
+  case 0xE8: // INX
+  case 0xCA: // DEX
+  case 0xC8: // INY
+  case 0x88: // DEY
+  case 0xA9: // LDA #
+  case 0xA2: // LDX #
+  case 0xA0: // LDY #
+  case 0xC9: // CMP #
+  case 0xE0: // CPX #
+  case 0xC0: // CPY #
+    return true;
+  default:
+    // Desvios condicionais
+    return (opcode & 0x1F) == 0x10;
+  }
+}
+
+} // namespace
+
+JitCode Jit::compile(const Block &block) {
+  // Pior caso de código emitido por instrução (com folga)
+  const size_t maxSize = 128 + block.ops.size() * 160;
+
+  if (code == nullptr) {
+    // Nunca gravável e executável ao mesmo tempo: as páginas ficam RW
+    // enquanto o código é copiado e passam a RX logo depois
+    void *memory = mmap(nullptr, CODE_CAPACITY, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      return nullptr;
+    }
+    code = static_cast<uint8_t *>(memory);
+  }
+  if (used + maxSize > CODE_CAPACITY) {
+    used = 0;
+    epoch++;
+  }
+
+  const uint64_t *generation = cpu.blockCache.getGenerationAddress();
+  const Cpu::JitHandler *handlers = Cpu::jitHandlers();
+  Emitter e{{&cpu.nResult, &cpu.zResult, &cpu.carryFlag, &cpu.overflowFlag,
+             &cpu.SR},
+            {}};
+
+  // Prólogo: rbx = cpu, r12d = ciclos, r13d = instruções,
+  // r14 = geração do cache na entrada do bloco
+  e.emit({0x53});                   // push rbx
+  e.emit({0x41, 0x54});             // push r12
+  e.emit({0x41, 0x55});             // push r13
+  e.emit({0x41, 0x56});             // push r14
+  e.emit({0x48, 0x83, 0xEC, 0x08}); // sub rsp, 8 (alinhamento)
+  e.emit({0x48, 0x89, 0xFB});       // mov rbx, rdi
+  e.emit({0x45, 0x31, 0xE4});       // xor r12d, r12d
+  e.emit({0x45, 0x31, 0xED});       // xor r13d, r13d
+  e.movRax(reinterpret_cast<uintptr_t>(generation));
+  e.emit({0x4C, 0x8B, 0x30}); // mov r14, [rax]
+
+  std::vector<size_t> toExit;
+
+  for (const MicroOp &op : block.ops) {
+    const opcodeParams params = opcodeInfo[op.opcode];
+    // Ciclos dos handlers nos modos em que pageCrossed é sempre verdadeiro
+    // (imediato e relativo)
+    const uint8_t cycles = params.cycles + params.cyclesOnPageCross;
+    const uint8_t value = op.operand & 0xFF;
+
+    if (TRACE_ENABLED) {
+      // PC, registradores e flags da instrução já estão na Cpu
+      e.emit({0x48, 0x89, 0xDF}); // mov rdi, rbx
+      e.emit({0xBE});             // mov esi, opcode | operand << 8
+      e.imm32(op.opcode | (op.operand << 8));
+      e.emit({0x44, 0x89, 0xE2}); // mov edx, r12d
+      e.movRax(reinterpret_cast<uintptr_t>(&Cpu::jitTrace));
+      e.emit({0xFF, 0xD0}); // call rax
+    }
+
+    if (!isNative(op.opcode)) {
+      // Handler do interpretador com o operando já decodificado
+      e.emit({0x48, 0x89, 0xDF}); // mov rdi, rbx
+      e.emit({0xBE});             // mov esi, operand
+      e.imm32(op.operand);
+      e.movRax(reinterpret_cast<uintptr_t>(handlers[op.opcode]));
+      e.emit({0xFF, 0xD0});       // call rax
+      e.emit({0x41, 0x01, 0xC4}); // add r12d, eax
+      e.emit({0x41, 0xFF, 0xC5}); // inc r13d
+      // Escrita em página com código: o bloco pode não ser mais válido
+      toExit.push_back(e.jumpIfGenerationChanged(generation));
+      continue;
+    }
+
+    uint8_t size = operandSize(op.opcode) + 1;
+    switch (op.opcode) {
+    case 0x18: // CLC
+      e.writeFlag(Flag::C, false);
+      break;
+    case 0x38: // SEC
+      e.writeFlag(Flag::C, true);
+      break;
+    case 0x58: // CLI
+      e.writeFlag(Flag::I, false);
+      break;
+    case 0x78: // SEI
+      e.writeFlag(Flag::I, true);
+      break;
+    case 0xB8: // CLV
+      e.writeFlag(Flag::V, false);
+      break;
+    case 0xD8: // CLD
+      e.writeFlag(Flag::D, false);
+      break;
+    case 0xF8: // SED
+      e.writeFlag(Flag::D, true);
+      break;
+    case 0xAA: // TAX
+      e.transfer(&cpu.AC, &cpu.X);
+      break;
+    case 0x8A: // TXA
+      e.transfer(&cpu.X, &cpu.AC);
+      break;
+    case 0xA8: // TAY
+      e.transfer(&cpu.AC, &cpu.Y);
+      break;
+    case 0x98: // TYA
+      e.transfer(&cpu.Y, &cpu.AC);
+      break;
+    case 0xE8: // INX
+      e.step(&cpu.X, true);
+      break;
+    case 0xCA: // DEX
+      e.step(&cpu.X, false);
+      break;
+    case 0xC8: // INY
+      e.step(&cpu.Y, true);
+      break;
+    case 0x88: // DEY
+      e.step(&cpu.Y, false);
+      break;
+    case 0xA9: // LDA #
+      e.load(&cpu.AC, value);
+      break;
+    case 0xA2: // LDX #
+      e.load(&cpu.X, value);
+      break;
+    case 0xA0: // LDY #
+      e.load(&cpu.Y, value);
+      break;
+    case 0xC9: // CMP #
+      e.compare(&cpu.AC, value);
+      break;
+    case 0xE0: // CPX #
+      e.compare(&cpu.X, value);
+      break;
+    case 0xC0: // CPY #
+      e.compare(&cpu.Y, value);
+      break;
+    default:
+      break;
+    }
+
+    if (params.addrMode == ADDR_MODE::RELATIVE) {
+      // Mesmo cálculo de Cpu::relative()
+      uint16_t target = (value & 0x80) == 0
+                            ? op.pc + value + 2
+                            : op.pc - static_cast<uint8_t>(~value + 1) + 2;
+      // BPL/BMI/BVC/BVS/BCC/BCS/BNE/BEQ: bits 7-6 escolhem a flag e o bit
+      // 5 indica se o desvio ocorre com a flag ativa
+      static const Flag flags[] = {Flag::N, Flag::V, Flag::C, Flag::Z};
+      e.branch(flags[op.opcode >> 6], (op.opcode & 0x20) != 0, &cpu.PC,
+               target, cycles + 1, op.pc + 2, params.cycles);
+    } else {
+      e.movRdx(&cpu.PC);
+      e.emit({0x66, 0x83, 0x02, size}); // add word [rdx], size
+      e.emit({0x41, 0x83, 0xC4,
+              params.addrMode == ADDR_MODE::IMMEDIATE ? cycles
+                                                      : params.cycles});
+    }
+    e.emit({0x41, 0xFF, 0xC5}); // inc r13d
+  }
+
+  // Epílogo: rax = (instruções << 32) | ciclos
+  size_t exit = e.bytes.size();
+  e.emit({0x44, 0x89, 0xE8});       // mov eax, r13d
+  e.emit({0x48, 0xC1, 0xE0, 0x20}); // shl rax, 32
+  e.emit({0x44, 0x89, 0xE1});       // mov ecx, r12d
+  e.emit({0x48, 0x09, 0xC8});       // or rax, rcx
+  e.emit({0x48, 0x83, 0xC4, 0x08}); // add rsp, 8
+  e.emit({0x41, 0x5E});             // pop r14
+  e.emit({0x41, 0x5D});             // pop r13
+  e.emit({0x41, 0x5C});             // pop r12
+  e.emit({0x5B});                   // pop rbx
+  e.emit({0xC3});                   // ret
+
+  for (size_t at : toExit) {
+    e.patch(at, exit);
+  }
+
+  uint8_t *entry = code + used;
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t first = reinterpret_cast<uintptr_t>(entry) & ~(pageSize - 1);
+  const size_t length =
+      reinterpret_cast<uintptr_t>(entry) + e.bytes.size() - first;
+  void *pages = reinterpret_cast<void *>(first);
+  if (mprotect(pages, length, PROT_READ | PROT_WRITE) != 0) {
+    return nullptr;
+  }
+  std::memcpy(entry, e.bytes.data(), e.bytes.size());
+  if (mprotect(pages, length, PROT_READ | PROT_EXEC) != 0) {
+    return nullptr;
+  }
+  used += e.bytes.size();
+  compiledBlocks++;
+  return reinterpret_cast<JitCode>(reinterpret_cast<uintptr_t>(entry));
+}
+
+#else
+
+JitCode Jit::compile(const Block &block) {
+  (void)block;
+  (void)cpu;
+  return nullptr;
+}
+
+#endif
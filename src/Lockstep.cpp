@@ -0,0 +1,470 @@
+#include "Lockstep.hpp"
+#include "Opcodes.hpp"
+
+namespace {
+
+// Instruções executadas em lote (as demais usam o Cpu da pista)
+enum class VectorOp {
+  NONE,
+  LDA, LDX, LDY,
+  STA, STX, STY,
+  AND, ORA, EOR, ADC, SBC,
+  CMP, CPX, CPY,
+  TAX, TXA, TAY, TYA,
+  INX, INY, DEX, DEY,
+  CLC, SEC, NOP,
+  BRANCH, JMP,
+};
+
+// Modos imediato, zeropage(,X/Y) e absoluto(,X/Y); o endereço de cada pista
+// é calculado sem acessar a memória
+VectorOp vectorOp(uint8_t opcode) {
+  switch (opcode) {
+  case 0xA9: case 0xA5: case 0xB5: case 0xAD: case 0xBD: case 0xB9:
+    return VectorOp::LDA;
+  case 0xA2: case 0xA6: case 0xB6: case 0xAE: case 0xBE:
+    return VectorOp::LDX;
+  case 0xA0: case 0xA4: case 0xB4: case 0xAC: case 0xBC:
+    return VectorOp::LDY;
+  case 0x85: case 0x95: case 0x8D: case 0x9D: case 0x99:
+    return VectorOp::STA;
+  case 0x86: case 0x96: case 0x8E:
+    return VectorOp::STX;
+  case 0x84: case 0x94: case 0x8C:
+    return VectorOp::STY;
+  case 0x29: case 0x25: case 0x35: case 0x2D: case 0x3D: case 0x39:
+    return VectorOp::AND;
+  case 0x09: case 0x05: case 0x15: case 0x0D: case 0x1D: case 0x19:
+    return VectorOp::ORA;
+  case 0x49: case 0x45: case 0x55: case 0x4D: case 0x5D: case 0x59:
+    return VectorOp::EOR;
+  case 0x69: case 0x65: case 0x75: case 0x6D: case 0x7D: case 0x79:
+    return VectorOp::ADC;
+  case 0xE9: case 0xE5: case 0xF5: case 0xED: case 0xFD: case 0xF9:
+    return VectorOp::SBC;
+  case 0xC9: case 0xC5: case 0xD5: case 0xCD: case 0xDD: case 0xD9:
+    return VectorOp::CMP;
+  case 0xE0: case 0xE4: case 0xEC:
+    return VectorOp::CPX;
+  case 0xC0: case 0xC4: case 0xCC:
+    return VectorOp::CPY;
+  case 0xAA: return VectorOp::TAX;
+  case 0x8A: return VectorOp::TXA;
+  case 0xA8: return VectorOp::TAY;
+  case 0x98: return VectorOp::TYA;
+  case 0xE8: return VectorOp::INX;
+  case 0xC8: return VectorOp::INY;
+  case 0xCA: return VectorOp::DEX;
+  case 0x88: return VectorOp::DEY;
+  case 0x18: return VectorOp::CLC;
+  case 0x38: return VectorOp::SEC;
+  case 0xEA: return VectorOp::NOP;
+  case 0x10: case 0x30: case 0x50: case 0x70:
+  case 0x90: case 0xB0: case 0xD0: case 0xF0:
+    return VectorOp::BRANCH;
+  case 0x4C: return VectorOp::JMP;
+  default:
+    return VectorOp::NONE;
+  }
+}
+
+bool readsOperand(VectorOp op) {
+  switch (op) {
+  case VectorOp::LDA: case VectorOp::LDX: case VectorOp::LDY:
+  case VectorOp::AND: case VectorOp::ORA: case VectorOp::EOR:
+  case VectorOp::ADC: case VectorOp::SBC:
+  case VectorOp::CMP: case VectorOp::CPX: case VectorOp::CPY:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// dst = src nas pistas do grupo (mask 0xFF), sem desvios por pista
+void blend(uint8_t *dst, const uint8_t *src, const uint8_t *mask) {
+  for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+    dst[l] = (src[l] & mask[l]) | (dst[l] & ~mask[l]);
+  }
+}
+
+} // namespace
+
+Lockstep::Lockstep(size_t count)
+    : lanes(count < 1 ? 1 : count > LOCKSTEP_LANES ? LOCKSTEP_LANES : count) {
+  for (size_t l = 0; l < lanes; l++) {
+    memories.emplace_back(new Memory());
+    memories[l]->enableSaveStatusToFile(false);
+    cpus.emplace_back(new Cpu(*memories[l]));
+  }
+}
+
+Lockstep::~Lockstep() {}
+
+void Lockstep::load(const std::vector<uint8_t> &program, uint16_t address,
+                    const std::vector<uint32_t> &seeds) {
+  for (size_t l = 0; l < lanes; l++) {
+    memories[l]->setRandomSeed(l < seeds.size() ? seeds[l] : l + 1);
+    memories[l]->loadProgram(program, address);
+    cpus[l]->reset();
+    cpus[l]->setAsmAddress(address);
+    pullFromCpu(l);
+    jammed[l] = false;
+    cycles[l] = instructions[l] = 0;
+  }
+  stats = LockstepStats();
+}
+
+size_t Lockstep::getLanes() const { return lanes; }
+
+CpuState Lockstep::getState(size_t lane) const {
+  return inCpu[lane] ? cpus[lane]->getState() : laneState(lane);
+}
+
+uint64_t Lockstep::getCycles(size_t lane) const { return cycles[lane]; }
+
+uint64_t Lockstep::getInstructions(size_t lane) const {
+  return instructions[lane];
+}
+
+bool Lockstep::isJammed(size_t lane) const { return jammed[lane]; }
+
+Memory &Lockstep::getMemory(size_t lane) { return *memories[lane]; }
+
+const LockstepStats &Lockstep::getStats() const { return stats; }
+
+// SR montado como em Cpu::getSR()
+CpuState Lockstep::laneState(size_t l) const {
+  const uint8_t sr = (regs.SR[l] & 0x3C) | (regs.nResult[l] & 0x80) |
+                     (regs.overflow[l] << 6) |
+                     (regs.zResult[l] == 0 ? 0x02 : 0x00) | regs.carry[l];
+  return {regs.PC[l], regs.SP[l], regs.AC[l], regs.X[l], regs.Y[l], sr};
+}
+
+void Lockstep::pullFromCpu(size_t l) {
+  const CpuState state = cpus[l]->getState();
+  regs.PC[l] = state.PC;
+  regs.SP[l] = state.SP;
+  regs.AC[l] = state.AC;
+  regs.X[l] = state.X;
+  regs.Y[l] = state.Y;
+  regs.SR[l] = state.SR;
+  regs.nResult[l] = state.SR;
+  regs.zResult[l] = (state.SR & 0x02) ? 0x00 : 0x01;
+  regs.carry[l] = state.SR & 0x01;
+  regs.overflow[l] = (state.SR >> 6) & 0x01;
+  inCpu[l] = false;
+}
+
+void Lockstep::pushToCpu(size_t l) {
+  cpus[l]->setState(laneState(l));
+  inCpu[l] = true;
+}
+
+uint32_t Lockstep::fetch(size_t lane, uint16_t pc) const {
+  const Memory &memory = *memories[lane];
+  const uint8_t opcode = memory.peek(pc);
+  const uint8_t size = operandSize(opcode);
+  uint32_t operand = 0;
+  if (size > 0) {
+    operand = memory.peek(pc + 1);
+  }
+  if (size > 1) {
+    operand |= memory.peek(pc + 2) << 8;
+  }
+  return opcode | operand << 8;
+}
+
+uint64_t Lockstep::run(uint64_t steps) {
+  uint64_t executed = 0;
+  for (; executed < steps; executed++) {
+    bool pending[LOCKSTEP_LANES]{};
+    bool any = false;
+    for (size_t l = 0; l < lanes; l++) {
+      pending[l] = !jammed[l];
+      any |= pending[l];
+    }
+    if (!any) {
+      break;
+    }
+
+    // Cada grupo é formado pela primeira pista pendente e pelas pistas com
+    // o mesmo PC e os mesmos bytes de instrução
+    size_t groups = 0;
+    for (size_t leader = 0; leader < lanes; leader++) {
+      if (!pending[leader]) {
+        continue;
+      }
+      groups++;
+      const uint16_t pc = regs.PC[leader];
+      const uint32_t instruction = fetch(leader, pc);
+      alignas(32) uint8_t mask[LOCKSTEP_LANES]{};
+      size_t size = 0;
+      for (size_t l = leader; l < lanes; l++) {
+        if (pending[l] && regs.PC[l] == pc && fetch(l, pc) == instruction) {
+          mask[l] = 0xFF;
+          pending[l] = false;
+          size++;
+        }
+      }
+
+      if (size > 1 && runVector(instruction & 0xFF, instruction >> 8, mask)) {
+        stats.vectorIssues++;
+        stats.vectorLanes += size;
+        continue;
+      }
+      for (size_t l = leader; l < lanes; l++) {
+        if (mask[l]) {
+          runScalar(l);
+        }
+      }
+    }
+    stats.steps++;
+    if (groups > 1) {
+      stats.divergentSteps++;
+    }
+  }
+  return executed;
+}
+
+void Lockstep::runScalar(size_t l) {
+  if (!inCpu[l]) {
+    pushToCpu(l);
+  }
+  Cpu &cpu = *cpus[l];
+  cycles[l] += cpu.next();
+  instructions[l]++;
+  regs.PC[l] = cpu.getPC();
+  jammed[l] = cpu.isJammed();
+  stats.scalarInstructions++;
+}
+
+bool Lockstep::runVector(uint8_t opcode, uint16_t operand,
+                         const uint8_t *mask) {
+  const VectorOp op = vectorOp(opcode);
+  if (op == VectorOp::NONE) {
+    return false;
+  }
+  for (size_t l = 0; l < lanes; l++) {
+    if (mask[l] && inCpu[l]) {
+      pullFromCpu(l);
+    }
+  }
+
+  const opcodeParams params = opcodeInfo[opcode];
+  Registers &r = regs;
+
+  // Endereço efetivo e "page boundary crossed" por pista (como em
+  // Cpu::getValueAddrMode: só os modos absolutos indexados testam a página)
+  static const uint8_t noIndex[LOCKSTEP_LANES] = {};
+  const ADDR_MODE mode = params.addrMode;
+  const uint8_t *index =
+      (mode == ADDR_MODE::ZEROPAGE_X || mode == ADDR_MODE::ABSOLUTE_X) ? r.X
+      : (mode == ADDR_MODE::ZEROPAGE_Y || mode == ADDR_MODE::ABSOLUTE_Y)
+          ? r.Y
+          : noIndex;
+  const uint16_t wrap = (mode == ADDR_MODE::ZEROPAGE ||
+                         mode == ADDR_MODE::ZEROPAGE_X ||
+                         mode == ADDR_MODE::ZEROPAGE_Y)
+                            ? 0x00FF
+                            : 0xFFFF;
+  const bool indexed =
+      mode == ADDR_MODE::ABSOLUTE_X || mode == ADDR_MODE::ABSOLUTE_Y;
+  alignas(32) uint16_t address[LOCKSTEP_LANES];
+  alignas(32) uint8_t crossed[LOCKSTEP_LANES];
+  for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+    address[l] = (operand + index[l]) & wrap;
+    crossed[l] = indexed ? ((address[l] ^ operand) & 0xFF00) != 0
+                         : mode != ADDR_MODE::NONE;
+  }
+
+  // Leituras (gather): cada pista lê da sua memória; $FE gera o número
+  // aleatório da pista
+  alignas(32) uint8_t value[LOCKSTEP_LANES]{};
+  if (readsOperand(op)) {
+    for (size_t l = 0; l < lanes; l++) {
+      if (mask[l]) {
+        value[l] = mode == ADDR_MODE::IMMEDIATE
+                       ? static_cast<uint8_t>(operand)
+                       : memories[l]->read(address[l]);
+      }
+    }
+  }
+
+  alignas(32) uint8_t cost[LOCKSTEP_LANES];
+  for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+    cost[l] = params.cycles + (crossed[l] ? params.cyclesOnPageCross : 0);
+  }
+  uint16_t next = regs.PC[0];
+  for (size_t l = 0; l < lanes; l++) {
+    if (mask[l]) {
+      next = r.PC[l] + operandSize(opcode) + 1;
+      break;
+    }
+  }
+
+  alignas(32) uint8_t result[LOCKSTEP_LANES];
+  alignas(32) uint8_t flag[LOCKSTEP_LANES];
+  switch (op) {
+  case VectorOp::LDA:
+    blend(r.AC, value, mask);
+    blend(r.nResult, value, mask);
+    blend(r.zResult, value, mask);
+    break;
+  case VectorOp::LDX:
+    blend(r.X, value, mask);
+    blend(r.nResult, value, mask);
+    blend(r.zResult, value, mask);
+    break;
+  case VectorOp::LDY:
+    blend(r.Y, value, mask);
+    blend(r.nResult, value, mask);
+    blend(r.zResult, value, mask);
+    break;
+  case VectorOp::STA:
+  case VectorOp::STX:
+  case VectorOp::STY: {
+    const uint8_t *source = op == VectorOp::STA   ? r.AC
+                            : op == VectorOp::STX ? r.X
+                                                  : r.Y;
+    for (size_t l = 0; l < lanes; l++) {
+      if (mask[l]) {
+        memories[l]->write(address[l], source[l]);
+      }
+    }
+    break;
+  }
+  case VectorOp::AND:
+  case VectorOp::ORA:
+  case VectorOp::EOR:
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      result[l] = op == VectorOp::AND   ? r.AC[l] & value[l]
+                  : op == VectorOp::ORA ? r.AC[l] | value[l]
+                                        : r.AC[l] ^ value[l];
+    }
+    blend(r.AC, result, mask);
+    blend(r.nResult, result, mask);
+    blend(r.zResult, result, mask);
+    break;
+  // ADC/SBC seguem os handlers do Cpu (V sempre limpo; em SBC o carry fica
+  // limpo quando o resultado é igual a AC e o custo ignora a página)
+  case VectorOp::ADC:
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      const uint16_t sum = r.AC[l] + value[l] + r.carry[l];
+      result[l] = sum;
+      flag[l] = sum > 0xFF;
+    }
+    blend(r.AC, result, mask);
+    blend(r.nResult, result, mask);
+    blend(r.zResult, result, mask);
+    blend(r.carry, flag, mask);
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      flag[l] = 0;
+    }
+    blend(r.overflow, flag, mask);
+    break;
+  case VectorOp::SBC:
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      const uint16_t difference = r.AC[l] - value[l] - (1 - r.carry[l]);
+      result[l] = difference;
+      flag[l] = difference < r.AC[l];
+      cost[l] = params.cycles;
+    }
+    blend(r.AC, result, mask);
+    blend(r.nResult, result, mask);
+    blend(r.zResult, result, mask);
+    blend(r.carry, flag, mask);
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      flag[l] = 0;
+    }
+    blend(r.overflow, flag, mask);
+    break;
+  case VectorOp::CMP:
+  case VectorOp::CPX:
+  case VectorOp::CPY: {
+    const uint8_t *reg = op == VectorOp::CMP   ? r.AC
+                         : op == VectorOp::CPX ? r.X
+                                               : r.Y;
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      result[l] = reg[l] - value[l];
+      flag[l] = reg[l] >= value[l];
+    }
+    blend(r.nResult, result, mask);
+    blend(r.zResult, result, mask);
+    blend(r.carry, flag, mask);
+    break;
+  }
+  case VectorOp::TAX:
+  case VectorOp::TAY:
+    blend(op == VectorOp::TAX ? r.X : r.Y, r.AC, mask);
+    blend(r.nResult, r.AC, mask);
+    blend(r.zResult, r.AC, mask);
+    break;
+  case VectorOp::TXA:
+  case VectorOp::TYA: {
+    const uint8_t *source = op == VectorOp::TXA ? r.X : r.Y;
+    blend(r.nResult, source, mask);
+    blend(r.zResult, source, mask);
+    blend(r.AC, source, mask);
+    break;
+  }
+  case VectorOp::INX:
+  case VectorOp::INY:
+  case VectorOp::DEX:
+  case VectorOp::DEY: {
+    uint8_t *reg = (op == VectorOp::INX || op == VectorOp::DEX) ? r.X : r.Y;
+    const uint8_t step = (op == VectorOp::INX || op == VectorOp::INY) ? 1 : 0xFF;
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      result[l] = reg[l] + step;
+    }
+    blend(reg, result, mask);
+    blend(r.nResult, result, mask);
+    blend(r.zResult, result, mask);
+    break;
+  }
+  case VectorOp::CLC:
+  case VectorOp::SEC:
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      flag[l] = op == VectorOp::SEC;
+    }
+    blend(r.carry, flag, mask);
+    break;
+  case VectorOp::NOP:
+    break;
+  case VectorOp::BRANCH: {
+    // Bits 7-6: flag (N, V, C, Z); bit 5: valor que desvia
+    const uint8_t condition = (opcode & 0x20) ? 1 : 0;
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      const uint8_t bit = (opcode >> 6) == 0   ? r.nResult[l] >> 7
+                          : (opcode >> 6) == 1 ? r.overflow[l]
+                          : (opcode >> 6) == 2 ? r.carry[l]
+                                               : r.zResult[l] == 0;
+      flag[l] = bit == condition ? 0xFF : 0x00;
+      cost[l] = params.cycles +
+                (flag[l] ? 0x01 + params.cyclesOnPageCross : 0);
+    }
+    const uint16_t target = next + static_cast<int8_t>(operand & 0xFF);
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      r.PC[l] = mask[l] ? (flag[l] ? target : next) : r.PC[l];
+    }
+    break;
+  }
+  case VectorOp::JMP:
+    next = operand;
+    break;
+  case VectorOp::NONE:
+    break;
+  }
+
+  if (op != VectorOp::BRANCH) {
+    for (size_t l = 0; l < LOCKSTEP_LANES; l++) {
+      r.PC[l] = mask[l] ? next : r.PC[l];
+    }
+  }
+  for (size_t l = 0; l < lanes; l++) {
+    if (mask[l]) {
+      cycles[l] += cost[l];
+      instructions[l]++;
+    }
+  }
+  return true;
+}
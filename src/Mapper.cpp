@@ -0,0 +1,309 @@
+#include "Mapper.hpp"
+#include <algorithm>
+
+namespace {
+
+// Banco entre 0 e count - 1 (negativo conta a partir do último)
+size_t wrapBank(int bank, size_t count) {
+  const long wrapped = bank % static_cast<long>(count);
+  return wrapped < 0 ? wrapped + count : wrapped;
+}
+
+} // namespace
+
+Mapper::Mapper(Cartridge &cartridge, Memory &memory, bool registers)
+    : cartridge(cartridge), memory(memory),
+      mirroring(cartridge.getHeader().mirroring),
+      handler(registers ? this : nullptr) {
+  memory.setResetWatcher(this);
+  memory.enableRandomSource(false);
+}
+
+Mapper::~Mapper() {
+  memory.setResetWatcher(nullptr);
+  memory.enableRandomSource(true);
+  for (size_t page = 0x80; page < 0x100; page++) {
+    memory.unmapRomPage(page);
+  }
+}
+
+uint8_t Mapper::readChr(uint16_t address) const {
+  return cartridge.getChr()[chrBanks[(address >> 10) & 0x07] +
+                            (address & 0x3FF)];
+}
+
+void Mapper::writeChr(uint16_t address, uint8_t value) {
+  if (cartridge.hasChrRam()) {
+    cartridge.getChrRam()[chrBanks[(address >> 10) & 0x07] +
+                          (address & 0x3FF)] = value;
+  }
+}
+
+const uint8_t *Mapper::getChrBank(uint8_t window) const {
+  return cartridge.getChr() + chrBanks[window & 0x07];
+}
+
+// Só reaponta as páginas (a Memory marca e avisa as que mudaram)
+void Mapper::mapPrg(uint16_t address, size_t size, int bank) {
+  const size_t prgSize = cartridge.getPrgSize();
+  const size_t offset =
+      wrapBank(bank, std::max<size_t>(1, prgSize / size)) * size;
+  bool switched = false;
+  for (size_t i = 0; i < size; i += 0x100) {
+    const size_t page = (address + i) >> 8;
+    const uint8_t *bytes = cartridge.getPrg() + (offset + i) % prgSize;
+    if (prgPages[page - 0x80] != bytes) {
+      prgPages[page - 0x80] = bytes;
+      memory.mapRomPage(page, bytes, handler);
+      switched = true;
+    }
+  }
+  if (switched) {
+    bankSwitches++;
+  }
+}
+
+void Mapper::onReset() {
+  mirroring = cartridge.getHeader().mirroring;
+  irq = false;
+  powerOn();
+  loadTrainer();
+}
+
+void Mapper::loadTrainer() {
+  if (cartridge.getTrainer() != nullptr) {
+    memory.writeBlock(0x7000, cartridge.getTrainer(), 512);
+  }
+}
+
+void Mapper::mapChr(uint16_t address, size_t size, int bank) {
+  const size_t chrSize = cartridge.getChrSize();
+  const size_t offset =
+      wrapBank(bank, std::max<size_t>(1, chrSize / size)) * size;
+  for (size_t i = 0; i < size; i += 0x400) {
+    chrBanks[((address + i) >> 10) & 0x07] = (offset + i) % chrSize;
+  }
+}
+
+NromMapper::NromMapper(Cartridge &cartridge, Memory &memory)
+    : Mapper(cartridge, memory, false) {
+  powerOn();
+}
+
+void NromMapper::powerOn() {
+  // 16 KiB aparecem também em $C000
+  mapPrg(0x8000, 0x8000, 0);
+  mapChr(0x0000, 0x2000, 0);
+}
+
+Mmc1Mapper::Mmc1Mapper(Cartridge &cartridge, Memory &memory)
+    : Mapper(cartridge, memory) {
+  powerOn();
+}
+
+// Último banco fixo em $C000
+void Mmc1Mapper::powerOn() {
+  shift = 0x10;
+  control = 0x0C;
+  chr0 = chr1 = prg = 0;
+  updateBanks();
+}
+
+// Cinco escritas (bit 0 primeiro) formam o valor; o bit 7 reinicia o
+// registrador serial e fixa o último banco em $C000
+void Mmc1Mapper::write(uint16_t address, uint8_t value) {
+  if (value & 0x80) {
+    shift = 0x10;
+    control |= 0x0C;
+    updateBanks();
+    return;
+  }
+  const bool full = shift & 0x01;
+  shift = (shift >> 1) | ((value & 0x01) << 4);
+  if (!full) {
+    return;
+  }
+  switch ((address >> 13) & 0x03) {
+  case 0:
+    control = shift;
+    break;
+  case 1:
+    chr0 = shift;
+    break;
+  case 2:
+    chr1 = shift;
+    break;
+  case 3:
+    prg = shift & 0x0F;
+    break;
+  }
+  shift = 0x10;
+  updateBanks();
+}
+
+void Mmc1Mapper::updateBanks() {
+  static const Mirroring modes[] = {Mirroring::SINGLE_LOWER,
+                                    Mirroring::SINGLE_UPPER,
+                                    Mirroring::VERTICAL, Mirroring::HORIZONTAL};
+  mirroring = modes[control & 0x03];
+
+  // SUROM (512 KiB): o bit 4 de CHR0 escolhe a metade de 256 KiB
+  const int outer = cartridge.getPrgSize() > 0x40000 ? (chr0 & 0x10) : 0;
+  switch ((control >> 2) & 0x03) {
+  case 0:
+  case 1:
+    mapPrg(0x8000, 0x8000, (outer | prg) >> 1);
+    break;
+  case 2:
+    mapPrg(0x8000, 0x4000, outer);
+    mapPrg(0xC000, 0x4000, outer | prg);
+    break;
+  case 3:
+    mapPrg(0x8000, 0x4000, outer | prg);
+    mapPrg(0xC000, 0x4000, outer | 0x0F);
+    break;
+  }
+
+  if (control & 0x10) {
+    mapChr(0x0000, 0x1000, chr0);
+    mapChr(0x1000, 0x1000, chr1);
+  } else {
+    mapChr(0x0000, 0x2000, chr0 >> 1);
+  }
+}
+
+UxromMapper::UxromMapper(Cartridge &cartridge, Memory &memory)
+    : Mapper(cartridge, memory) {
+  powerOn();
+}
+
+void UxromMapper::powerOn() {
+  mapPrg(0x8000, 0x4000, 0);
+  mapPrg(0xC000, 0x4000, -1);
+  mapChr(0x0000, 0x2000, 0);
+}
+
+void UxromMapper::write(uint16_t, uint8_t value) {
+  mapPrg(0x8000, 0x4000, value);
+}
+
+CnromMapper::CnromMapper(Cartridge &cartridge, Memory &memory)
+    : Mapper(cartridge, memory) {
+  powerOn();
+}
+
+void CnromMapper::powerOn() {
+  mapPrg(0x8000, 0x8000, 0);
+  mapChr(0x0000, 0x2000, 0);
+}
+
+void CnromMapper::write(uint16_t, uint8_t value) {
+  mapChr(0x0000, 0x2000, value);
+}
+
+Mmc3Mapper::Mmc3Mapper(Cartridge &cartridge, Memory &memory)
+    : Mapper(cartridge, memory) {
+  powerOn();
+}
+
+void Mmc3Mapper::powerOn() {
+  bankSelect = 0;
+  registers = {{0, 2, 4, 5, 6, 7, 0, 1}};
+  irqLatch = irqCounter = 0;
+  irqReload = irqEnabled = false;
+  updateBanks();
+}
+
+// Pares de registradores (endereço par/ímpar) em $8000, $A000, $C000 e
+// $E000
+void Mmc3Mapper::write(uint16_t address, uint8_t value) {
+  const bool odd = address & 0x01;
+  switch ((address >> 13) & 0x03) {
+  case 0:
+    if (odd) {
+      registers[bankSelect & 0x07] = value;
+    } else {
+      bankSelect = value;
+    }
+    updateBanks();
+    break;
+  case 1:
+    // Proteção da PRG RAM ignorada (sempre habilitada)
+    if (!odd && mirroring != Mirroring::FOUR_SCREEN) {
+      mirroring = (value & 0x01) ? Mirroring::HORIZONTAL : Mirroring::VERTICAL;
+    }
+    break;
+  case 2:
+    if (odd) {
+      irqCounter = 0;
+      irqReload = true;
+    } else {
+      irqLatch = value;
+    }
+    break;
+  case 3:
+    irqEnabled = odd;
+    if (!odd) {
+      irq = false;
+    }
+    break;
+  }
+}
+
+void Mmc3Mapper::onScanline() {
+  if (irqCounter == 0 || irqReload) {
+    irqCounter = irqLatch;
+    irqReload = false;
+  } else {
+    irqCounter--;
+  }
+  if (irqCounter == 0 && irqEnabled) {
+    irq = true;
+  }
+}
+
+void Mmc3Mapper::updateBanks() {
+  // Bit 6: R6 em $8000 ou em $C000 (o penúltimo banco fica no outro)
+  const bool prgMode = bankSelect & 0x40;
+  mapPrg(prgMode ? 0xC000 : 0x8000, 0x2000, registers[6] & 0x3F);
+  mapPrg(0xA000, 0x2000, registers[7] & 0x3F);
+  mapPrg(prgMode ? 0x8000 : 0xC000, 0x2000, -2);
+  mapPrg(0xE000, 0x2000, -1);
+
+  // Bit 7: janelas de 2 KiB em $1000 em vez de $0000
+  const uint16_t invert = (bankSelect & 0x80) ? 0x1000 : 0x0000;
+  mapChr(0x0000 ^ invert, 0x0800, registers[0] >> 1);
+  mapChr(0x0800 ^ invert, 0x0800, registers[1] >> 1);
+  mapChr(0x1000 ^ invert, 0x0400, registers[2]);
+  mapChr(0x1400 ^ invert, 0x0400, registers[3]);
+  mapChr(0x1800 ^ invert, 0x0400, registers[4]);
+  mapChr(0x1C00 ^ invert, 0x0400, registers[5]);
+}
+
+std::unique_ptr<Mapper> createMapper(Cartridge &cartridge, Memory &memory) {
+  if (!cartridge.isOpen()) {
+    return nullptr;
+  }
+  std::unique_ptr<Mapper> mapper;
+  switch (cartridge.getHeader().mapper) {
+  case 0:
+    mapper.reset(new NromMapper(cartridge, memory));
+    break;
+  case 1:
+    mapper.reset(new Mmc1Mapper(cartridge, memory));
+    break;
+  case 2:
+    mapper.reset(new UxromMapper(cartridge, memory));
+    break;
+  case 3:
+    mapper.reset(new CnromMapper(cartridge, memory));
+    break;
+  case 4:
+    mapper.reset(new Mmc3Mapper(cartridge, memory));
+    break;
+  default:
+    return nullptr;
+  }
+  mapper->loadTrainer();
+  return mapper;
+}
@@ -1,7 +1,10 @@
 #include "Mem.hpp"
+#include "MemoryDump.hpp"
+#include "RomImage.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <ctime>
-#include <fstream>
 #include <iostream>
 
 /*
@@ -18,129 +21,509 @@ See CPU Test Mode | $4020–$FFFF   | $BFE0 | Cartridge space: PRG ROM, PRG RAM,
 and mapper registers
 */
 
-Memory::Memory() {}
+Memory::Memory() {
+  setRandomSeed(time(NULL));
+
+  // $0000–$1FFF: 2 KiB de RAM e três espelhos
+  for (size_t page = 0x00; page < 0x20; page++) {
+    mapPage(page, &data[(page & 0x07) << 8], true, nullptr);
+  }
+  // $2000–$3FFF: leitura direta da visão espelhada, escrita pelo handler
+  for (size_t page = 0x20; page < 0x40; page++) {
+    mapPage(page, &data[0x2000], false, &registers);
+  }
+  // $4000–$FFFF: sem espelhamento
+  for (size_t page = 0x40; page < 0x100; page++) {
+    mapPage(page, &data[page << 8], true, nullptr);
+  }
+  linkAliases();
+}
 
 Memory::~Memory() {}
 
-// Preenche a memória com dados aleatórios
-void Memory::fillRandomData() {
-  srand(time(NULL));
-  for (auto &i : data) {
-    i = rand() % 0x0F;
+void RegisterMirror::write(uint16_t address, uint8_t value) {
+  for (size_t i = address & 0x07; i < 0x100; i += 0x08) {
+    page[i] = value;
   }
-  saveMemoryStatusToFile();
 }
 
-void Memory::fillSequencialData() {
-  for (size_t i = 0; i < data.size(); i++) {
-    data[i] = i;
+void Memory::mapPage(uint8_t page, uint8_t *storage, bool writable,
+                     PageHandler *handler) {
+  readPages[page] = storage;
+  writePages[page] = writable ? storage : nullptr;
+  handlers[page] = handler;
+  pageStorage[page] = storage;
+}
+
+// Agrupa as páginas com o mesmo armazenamento em anéis (a primeira é a
+// canônica); cada página de ROM fica sozinha no seu anel
+void Memory::linkAliases() {
+  std::array<int, 0x100> last;
+  last.fill(-1);
+  for (size_t page = 0; page < 0x100; page++) {
+    int first = -1;
+    for (size_t other = 0; other < page && !romPages[page]; other++) {
+      if (!romPages[other] && pageStorage[other] == pageStorage[page]) {
+        first = canonicalPages[other];
+        break;
+      }
+    }
+    if (first < 0) {
+      canonicalPages[page] = page;
+      nextAlias[page] = page;
+      last[page] = page;
+      continue;
+    }
+    canonicalPages[page] = first;
+    nextAlias[page] = first;
+    nextAlias[last[first]] = page;
+    last[first] = page;
   }
-  saveMemoryStatusToFile();
 }
 
-void Memory::fillZeroData() {
-  for (int i = 0; i < MEMSIZE; i++) {
-    data[i] = 0;
+void Memory::mapRomPage(uint8_t page, const uint8_t *bytes,
+                        PageHandler *handler) {
+  uint8_t *storage = const_cast<uint8_t *>(bytes);
+  const bool device = handlers[page] == &deviceDispatch;
+  if (romPages[page] && pageStorage[page] == storage &&
+      (device ? fallbackHandlers[page] : handlers[page]) == handler) {
+    return;
+  }
+  const bool relink = !romPages[page];
+  romPages[page] = true;
+  pageStorage[page] = storage;
+  if (device) {
+    fallbackRead[page] = storage;
+    fallbackWrite[page] = nullptr;
+    fallbackHandlers[page] = handler;
+  } else {
+    readPages[page] = storage;
+    writePages[page] = nullptr;
+    handlers[page] = handler;
+  }
+  // A troca de banco não passa pelo anel: só a primeira vez reagrupa
+  if (relink) {
+    linkAliases();
+  }
+  markPageDirty(page);
+  if (watchedCount > 0) {
+    notifyWrite(page);
   }
-  saveMemoryStatusToFile();
 }
 
-// Função que verifica se um determinado endereço está em um espaço mirrored,
-// e então corrige pra um valor de endereço válido.
-uint16_t verifyMirroredAddress(uint16_t address) {
-  if (address >= 0x1000 || address >= 0x4000) {
-    return address;
+void Memory::unmapRomPage(uint8_t page) {
+  if (!romPages[page]) {
+    return;
+  }
+  romPages[page] = false;
+  uint8_t *storage = data + (page << 8);
+  if (handlers[page] == &deviceDispatch) {
+    pageStorage[page] = storage;
+    fallbackRead[page] = fallbackWrite[page] = storage;
+    fallbackHandlers[page] = nullptr;
+  } else {
+    mapPage(page, storage, true, nullptr);
   }
+  linkAliases();
+  markPageDirty(page);
+  if (watchedCount > 0) {
+    notifyWrite(page);
+  }
+}
 
-  if (address >= 0x1000 && address <= 0x1FFF) {
-    return (address % 0x1000);
+void Memory::attachDevice(uint16_t begin, uint16_t end,
+                          PageHandler *device) {
+  if (device == nullptr || end < begin) {
+    return;
+  }
+  devices.push_back({begin, end, device});
+  for (size_t page = begin >> 8; page <= static_cast<size_t>(end >> 8);
+       page++) {
+    if (handlers[page] == &deviceDispatch) {
+      continue;
+    }
+    fallbackRead[page] = readPages[page];
+    fallbackWrite[page] = writePages[page];
+    fallbackHandlers[page] = handlers[page];
+    readPages[page] = writePages[page] = nullptr;
+    handlers[page] = &deviceDispatch;
   }
+}
 
-  if (address >= 0x2008 && address <= 0x3FFF) {
-    return (address % 0x0008);
+void Memory::detachDevice(PageHandler *device) {
+  devices.erase(std::remove_if(devices.begin(), devices.end(),
+                               [device](const MmioRange &range) {
+                                 return range.device == device;
+                               }),
+                devices.end());
+  // Páginas sem nenhuma faixa voltam ao mapeamento anterior
+  for (size_t page = 0; page < 0x100; page++) {
+    if (handlers[page] != &deviceDispatch) {
+      continue;
+    }
+    const bool used =
+        std::any_of(devices.begin(), devices.end(), [page](const MmioRange &r) {
+          return (r.begin >> 8) <= page && page <= (r.end >> 8);
+        });
+    if (!used) {
+      readPages[page] = fallbackRead[page];
+      writePages[page] = fallbackWrite[page];
+      handlers[page] = fallbackHandlers[page];
+    }
   }
+}
 
-  return address;
+// Poucas faixas: busca linear da mais recente para a mais antiga
+const MmioRange *Memory::findDevice(uint16_t address) const {
+  for (auto range = devices.rbegin(); range != devices.rend(); ++range) {
+    if (range->begin <= address && address <= range->end) {
+      return &*range;
+    }
+  }
+  return nullptr;
 }
 
-uint8_t Memory::read(uint16_t address) {
-  // uint16_t veriAddr = verifyMirroredAddress(address);
-  return data[address];
+uint8_t Memory::DeviceDispatch::read(uint16_t address) {
+  const MmioRange *range = memory.findDevice(address);
+  if (range != nullptr) {
+    return range->device->read(address);
+  }
+  const uint8_t page = address >> 8;
+  const uint8_t *bytes = memory.fallbackRead[page];
+  return bytes != nullptr ? bytes[address & 0xFF]
+                          : memory.fallbackHandlers[page]->read(address);
 }
 
-void Memory::enableSaveStatusToFile(bool enable) {
-  saveStatusToFile = enable;  
+uint8_t Memory::DeviceDispatch::peek(uint16_t address) const {
+  const MmioRange *range = memory.findDevice(address);
+  if (range != nullptr) {
+    return range->device->peek(address);
+  }
+  const uint8_t page = address >> 8;
+  const uint8_t *bytes = memory.fallbackRead[page];
+  return bytes != nullptr ? bytes[address & 0xFF]
+                          : memory.fallbackHandlers[page]->peek(address);
 }
 
-void Memory::saveMemoryStatusToFile() {
-  if (!saveStatusToFile) {
+void Memory::DeviceDispatch::write(uint16_t address, uint8_t value) {
+  const MmioRange *range = memory.findDevice(address);
+  if (range != nullptr) {
+    range->device->write(address, value);
     return;
   }
+  const uint8_t page = address >> 8;
+  uint8_t *bytes = memory.fallbackWrite[page];
+  if (bytes != nullptr) {
+    bytes[address & 0xFF] = value;
+  } else if (memory.fallbackHandlers[page] != nullptr) {
+    memory.fallbackHandlers[page]->write(address, value);
+  }
+}
 
-  std::ofstream file("memory_status/memory.bin", std::ios::trunc);
-  if (file.is_open()) {
-    for (size_t i = 0; i < data.size(); i++) {
-      file << data[i];
-    }
+// Preenche a memória com dados aleatórios
+void Memory::fillRandomData() {
+  srand(time(NULL));
+  for (uint32_t address = 0; address < MEMSIZE; address++) {
+    write(address, rand() % 0x0F);
+  }
+  notifyAllPages();
+  saveMemoryStatusToFile();
+}
+
+void Memory::fillSequencialData() {
+  for (uint32_t address = 0; address < MEMSIZE; address++) {
+    write(address, address);
+  }
+  notifyAllPages();
+  saveMemoryStatusToFile();
+}
+
+void Memory::fillZeroData() {
+  std::fill(data, data + MEMSIZE, 0);
+  notifyAllPages();
+  saveMemoryStatusToFile();
+}
+
+void Memory::setRandomSeed(uint32_t seed) {
+  randomState = seed != 0 ? seed : 0x2545F491;
+}
+
+void Memory::enableRandomSource(bool enable) { randomSource = enable; }
+
+// xorshift32; o valor gerado fica em $FE (visível com peek e na busca de
+// instruções)
+uint8_t Memory::nextRandom() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  data[RANDOM_ADDRESS] = (randomState % 0xFF) + 1;
+  markDirty(RANDOM_ADDRESS >> 8, RANDOM_ADDRESS);
+  if (watchedCount > 0) {
+    notifyWrite(RANDOM_ADDRESS >> 8);
   }
+  return data[RANDOM_ADDRESS];
 }
 
-void Memory::write(uint16_t address, uint8_t value) {
-  /*
-  | Address range | Size  | Device
-  | $0000–$07FF   | $0800 | 2 KB internal RAM
-  | $0800–$0FFF   | $0800 |\
-  | $1000–$17FF   | $0800 | Mirrors of $0000–$07FF
-  | $1800–$1FFF   | $0800 |/
-  | $2000–$2007   | $0008 | NES PPU registers
-  | $2008–$3FFF   | $1FF8 | Mirrors of $2000–$2007 (repeats every 8 bytes)
-  | $4000–$4017   | $0018 | NES APU and I/O registers
-  | $4018–$401F   | $0008 | APU and I/O functionality that is normally disabled.
-  See CPU Test Mode | $4020–$FFFF   | $BFE0 | Cartridge space: PRG ROM, PRG RAM,
-  and mapper registers
-  */
-  if (address < 0x2000) {
-    for (size_t i = 0x00; i < 0x2000; i += 0x0800) {
-      data[address + i] = value;
+void Memory::enableSaveStatusToFile(bool enable, unsigned intervalMs) {
+  if (!enable) {
+    if (statusDump) {
+      relocate(ownData.data());
+      statusDump.reset();
+      removeDirtyConsumer(statusConsumer);
     }
-    saveMemoryStatusToFile();
     return;
   }
-  if (address >= 0x2000 && address < 0x4000) {
-    for (size_t i = 0x00; i < 0x4000; i += 0x0008) {
-      data[address + i] = value;
-    }
-    saveMemoryStatusToFile();
+  // Novo intervalo: volta ao armazenamento próprio antes de remapear
+  enableSaveStatusToFile(false);
+  std::unique_ptr<MemoryDump> dump(new MemoryDump(
+      "memory_status/memory.bin", MEMSIZE,
+      std::chrono::milliseconds(intervalMs)));
+  if (!dump->isOpen()) {
     return;
   }
-  data[address] = value;
+  statusDump = std::move(dump);
+  relocate(statusDump->getImage());
+  // A primeira consulta devolve tudo: os espelhos são copiados inteiros
+  statusConsumer = addDirtyConsumer();
   saveMemoryStatusToFile();
 }
 
-void Memory::loadMemoryFromFile(std::string path, uint16_t addrBegin) {
-  std::ifstream file(path, std::ios::binary);
+// As páginas no próprio lugar do armazenamento já estão no arquivo; nas
+// demais (espelhos e ROM) são copiadas as linhas alteradas da origem
+void Memory::saveMemoryStatusToFile() {
+  if (!statusDump) {
+    return;
+  }
+  const DirtyRegions dirty = consumeDirty(statusConsumer);
+  for (size_t page = 0; page < 0x100; page++) {
+    uint8_t *image = data + (page << 8);
+    if (pageStorage[page] == image || !dirty.isPageDirty(page)) {
+      continue;
+    }
+    for (size_t line = 0; line < 0x100; line += DirtyRegions::LINE_SIZE) {
+      if (dirty.isLineDirty((page << 8) | line)) {
+        std::memcpy(image + line, pageStorage[page] + line,
+                    DirtyRegions::LINE_SIZE);
+      }
+    }
+  }
+}
 
-  if (!file.is_open()) {
-    std::cerr << "Error in open file \"" << path << "\"\n";
-    exit(1);
+void Memory::relocate(uint8_t *storage) {
+  if (storage == data) {
+    return;
   }
+  std::memcpy(storage, data, MEMSIZE);
+  const uint8_t *begin = data;
+  const uint8_t *end = data + MEMSIZE;
+  auto rebase = [&](std::array<uint8_t *, 0x100> &pages) {
+    for (uint8_t *&bytes : pages) {
+      if (bytes != nullptr && bytes >= begin && bytes < end) {
+        bytes = storage + (bytes - begin);
+      }
+    }
+  };
+  rebase(readPages);
+  rebase(writePages);
+  rebase(pageStorage);
+  rebase(fallbackRead);
+  rebase(fallbackWrite);
+  registers = RegisterMirror(storage + 0x2000);
+  data = storage;
+}
 
-  char byte{};
-  uint16_t i = 0;
-  while (file.read(&byte, sizeof(char))) {
-    write((i + addrBegin), byte);
-    ++i;
+void Memory::writeBlock(uint16_t address, const uint8_t *bytes,
+                        size_t size) {
+  while (size > 0) {
+    const uint8_t page = address >> 8;
+    const size_t offset = address & 0xFF;
+    const size_t chunk = std::min(size, 0x100 - offset);
+    uint8_t *storage = writePages[page];
+    if (storage == nullptr) {
+      // Registradores/dispositivos: byte a byte pelo handler
+      for (size_t i = 0; i < chunk; i++) {
+        write(address + i, bytes[i]);
+      }
+    } else {
+      std::memcpy(storage + offset, bytes, chunk);
+      for (size_t line = offset; line < offset + chunk;
+           line += DirtyRegions::LINE_SIZE) {
+        markDirty(page, (address & 0xFF00) | line);
+      }
+      markDirty(page, address + chunk - 1);
+      if (watchedCount > 0) {
+        notifyWrite(page);
+      }
+    }
+    address += chunk;
+    bytes += chunk;
+    size -= chunk;
   }
+}
 
+void Memory::loadMemoryFromFile(std::string path, uint16_t addrBegin) {
+  std::unique_ptr<RomImage> image(new RomImage(path));
+  if (!image->isOpen()) {
+    std::cerr << "Error in open file \"" << path << "\"\n";
+    exit(1);
+  }
+  rom = std::move(image);
   filePath = path;
+  program.clear();
+  asmAddress = addrBegin;
+  writeBlock(addrBegin, rom->getData(), rom->getSize());
   saveMemoryStatusToFile();
+}
+
+void Memory::loadProgram(const std::vector<uint8_t> &bytes,
+                         uint16_t addrBegin) {
+  program = bytes;
+  filePath.clear();
+  rom.reset();
   asmAddress = addrBegin;
+  writeBlock(addrBegin, program.data(), program.size());
+  saveMemoryStatusToFile();
 }
 
+// Recarrega da imagem já mapeada (ou do programa em memória)
 void Memory::reset() {
   fillZeroData();
-  loadMemoryFromFile(filePath, asmAddress);
+  if (rom) {
+    writeBlock(asmAddress, rom->getData(), rom->getSize());
+  } else {
+    writeBlock(asmAddress, program.data(), program.size());
+  }
+  if (resetWatcher != nullptr) {
+    resetWatcher->onReset();
+  }
   saveMemoryStatusToFile();
 }
 
+void Memory::setResetWatcher(ResetWatcher *watcher) { resetWatcher = watcher; }
+
 std::string Memory::getFilePath() { return filePath; }
+
+void Memory::setPageWatcher(PageWatcher *watcher) {
+  pageWatcher = watcher;
+  if (watcher == nullptr) {
+    watchedPages.fill(false);
+    watchedCount = 0;
+  }
+}
+
+// Páginas só são observadas com um PageWatcher definido
+void Memory::watchPage(uint8_t page) {
+  if (pageWatcher != nullptr && !watchedPages[page]) {
+    watchedPages[page] = true;
+    watchedCount++;
+  }
+}
+
+void Memory::unwatchPage(uint8_t page) {
+  if (watchedPages[page]) {
+    watchedPages[page] = false;
+    watchedCount--;
+  }
+}
+
+// Escritas em bloco (fill*) marcam todas as páginas e notificam as
+// observadas de uma vez
+void Memory::notifyAllPages() {
+  dirtyLines.fill(~static_cast<uint64_t>(0));
+  for (size_t page = 0; page < watchedPages.size(); page++) {
+    if (watchedPages[page]) {
+      pageWatcher->onPageWrite(page);
+    }
+  }
+}
+
+size_t Memory::addDirtyConsumer() {
+  size_t consumer = 0;
+  while (consumer < dirtyConsumers.size() && dirtyConsumers[consumer].active) {
+    consumer++;
+  }
+  if (consumer == dirtyConsumers.size()) {
+    dirtyConsumers.emplace_back();
+  }
+  dirtyConsumers[consumer].active = true;
+  dirtyConsumers[consumer].lines.fill(~static_cast<uint64_t>(0));
+  return consumer;
+}
+
+void Memory::removeDirtyConsumer(size_t consumer) {
+  if (consumer < dirtyConsumers.size()) {
+    dirtyConsumers[consumer].active = false;
+  }
+}
+
+DirtyRegions Memory::consumeDirty(size_t consumer) {
+  // Repassa as marcações pendentes a todos os consumidores
+  for (DirtyConsumer &pending : dirtyConsumers) {
+    if (pending.active) {
+      for (size_t i = 0; i < dirtyLines.size(); i++) {
+        pending.lines[i] |= dirtyLines[i];
+      }
+    }
+  }
+  dirtyLines.fill(0);
+
+  // Do armazenamento para o espaço de endereços (espelhos incluídos)
+  DirtyRegions regions;
+  DirtyLines &lines = dirtyConsumers[consumer].lines;
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t canonical = canonicalPages[page];
+    const uint64_t bits =
+        (lines[canonical >> 4] >> ((canonical & 0x0F) << 2)) & 0x0F;
+    regions.lines[page >> 4] |= bits << ((page & 0x0F) << 2);
+  }
+  lines.fill(0);
+  return regions;
+}
+
+const uint8_t *Memory::getPage(uint8_t page) const {
+  return pageStorage[page];
+}
+
+void Memory::restorePage(uint8_t page, const uint8_t *bytes) {
+  if (romPages[page]) {
+    return;
+  }
+  std::memcpy(pageStorage[page], bytes, 0x100);
+  dirtyLines[canonicalPages[page] >> 4] |=
+      static_cast<uint64_t>(0x0F) << ((canonicalPages[page] & 0x0F) << 2);
+  if (watchedCount > 0) {
+    notifyWrite(page);
+  }
+}
+
+uint32_t Memory::getRandomState() const { return randomState; }
+
+int32_t Memory::firstDifference(const Memory &other) const {
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t *bytes = pageStorage[page];
+    const uint8_t *otherBytes = other.pageStorage[page];
+    if (std::memcmp(bytes, otherBytes, 0x100) == 0) {
+      continue;
+    }
+    for (size_t i = 0; i < 0x100; i++) {
+      if (bytes[i] != otherBytes[i]) {
+        return (page << 8) | i;
+      }
+    }
+  }
+  return -1;
+}
+
+// Sobre o conteúdo visto pelo programa (espelhos incluídos)
+uint64_t Memory::hash() const {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t *bytes = pageStorage[page];
+    for (size_t i = 0; i < 0x100; i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, &bytes[i], sizeof(word));
+      hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+  }
+  return hash;
+}
@@ -0,0 +1,64 @@
+#include "MemoryDump.hpp"
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+MemoryDump::MemoryDump(const std::string &path, size_t size,
+                       std::chrono::milliseconds interval)
+    : size(size), interval(interval) {
+  fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0 || ftruncate(fd, size) != 0) {
+    std::cerr << "Error in open file \"" << path << "\"\n";
+    return;
+  }
+  void *mapped =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "Error in map file \"" << path << "\"\n";
+    return;
+  }
+  image = static_cast<uint8_t *>(mapped);
+  thread = std::thread(&MemoryDump::flushLoop, this);
+}
+
+MemoryDump::~MemoryDump() {
+  if (thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+  }
+  if (image != nullptr) {
+    flush();
+    munmap(image, size);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+void MemoryDump::flush() {
+  msync(image, size, MS_SYNC);
+  std::lock_guard<std::mutex> lock(mutex);
+  flushes++;
+}
+
+uint64_t MemoryDump::getFlushes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return flushes;
+}
+
+// O msync só lê a imagem pelo kernel: a emulação continua escrevendo nela
+// sem sincronização, e cada gravação leva o estado daquele momento
+void MemoryDump::flushLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+    lock.unlock();
+    msync(image, size, MS_SYNC);
+    lock.lock();
+    flushes++;
+  }
+}
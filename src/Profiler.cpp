@@ -0,0 +1,114 @@
+#include "Profiler.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+Profiler::Profiler() {
+  if (PROFILER_ENABLED) {
+    pcCount.resize(0x10000);
+    pcCycles.resize(0x10000);
+    pcOpcode.resize(0x10000);
+  }
+}
+
+Profiler::~Profiler() {}
+
+void Profiler::clear() {
+  opcodeCount.fill(0);
+  opcodeCycles.fill(0);
+  std::fill(pcCount.begin(), pcCount.end(), 0);
+  std::fill(pcCycles.begin(), pcCycles.end(), 0);
+  std::fill(pcOpcode.begin(), pcOpcode.end(), 0);
+}
+
+std::vector<ProfileEntry> Profiler::topAddresses(size_t n) const {
+  std::vector<ProfileEntry> entries;
+  for (size_t pc = 0; pc < pcCount.size(); pc++) {
+    if (pcCount[pc] > 0) {
+      entries.push_back({static_cast<uint16_t>(pc), pcOpcode[pc], pcCount[pc],
+                         pcCycles[pc]});
+    }
+  }
+
+  n = std::min(n, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                    [](const ProfileEntry &a, const ProfileEntry &b) {
+                      return a.count > b.count;
+                    });
+  entries.resize(n);
+  return entries;
+}
+
+namespace {
+
+const std::string &opcodeLabel(uint8_t opcode) { return opcodesList[opcode]; }
+
+std::string hexString(unsigned value, int width) {
+  std::stringstream ss;
+  ss << "0x" << std::setfill('0') << std::setw(width) << std::uppercase
+     << std::hex << value;
+  return ss.str();
+}
+
+} // namespace
+
+void Profiler::exportCSV(std::ostream &out) const {
+  out << "kind,key,label,count,cycles\n";
+  for (size_t opcode = 0; opcode < opcodeCount.size(); opcode++) {
+    if (opcodeCount[opcode] > 0) {
+      out << "opcode," << hexString(opcode, 2) << ",\""
+          << opcodeLabel(opcode) << "\"," << std::dec << opcodeCount[opcode]
+          << "," << opcodeCycles[opcode] << "\n";
+    }
+  }
+  for (size_t pc = 0; pc < pcCount.size(); pc++) {
+    if (pcCount[pc] > 0) {
+      out << "pc," << hexString(pc, 4) << ",\"" << opcodeLabel(pcOpcode[pc])
+          << "\"," << std::dec << pcCount[pc] << "," << pcCycles[pc] << "\n";
+    }
+  }
+}
+
+void Profiler::exportJSON(std::ostream &out) const {
+  const char *separator = "";
+  out << "{\n  \"opcodes\": [";
+  for (size_t opcode = 0; opcode < opcodeCount.size(); opcode++) {
+    if (opcodeCount[opcode] > 0) {
+      out << separator << "\n    {\"opcode\": \"" << hexString(opcode, 2)
+          << "\", \"label\": \"" << opcodeLabel(opcode)
+          << "\", \"count\": " << std::dec << opcodeCount[opcode]
+          << ", \"cycles\": " << opcodeCycles[opcode] << "}";
+      separator = ",";
+    }
+  }
+  separator = "";
+  out << "\n  ],\n  \"addresses\": [";
+  for (size_t pc = 0; pc < pcCount.size(); pc++) {
+    if (pcCount[pc] > 0) {
+      out << separator << "\n    {\"pc\": \"" << hexString(pc, 4)
+          << "\", \"label\": \"" << opcodeLabel(pcOpcode[pc])
+          << "\", \"count\": " << std::dec << pcCount[pc]
+          << ", \"cycles\": " << pcCycles[pc] << "}";
+      separator = ",";
+    }
+  }
+  out << "\n  ]\n}\n";
+}
+
+bool Profiler::exportToFile(const std::string &path) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  const std::string json = ".json";
+  if (path.size() >= json.size() &&
+      path.compare(path.size() - json.size(), json.size(), json) == 0) {
+    exportJSON(file);
+  } else {
+    exportCSV(file);
+  }
+  return true;
+}
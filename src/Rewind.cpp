@@ -0,0 +1,150 @@
+#include "Rewind.hpp"
+#include <cstring>
+
+namespace {
+
+void putVarint(std::vector<uint8_t> &out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+uint32_t getVarint(const std::vector<uint8_t> &in, size_t &pos) {
+  uint32_t value = 0;
+  for (int shift = 0; pos < in.size(); shift += 7) {
+    const uint8_t byte = in[pos++];
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  return value;
+}
+
+} // namespace
+
+RewindBuffer::RewindBuffer(Cpu &cpu, Memory &memory, size_t maxFrames,
+                           size_t maxBytes)
+    : cpu(cpu), memory(memory), maxFrames(maxFrames < 1 ? 1 : maxFrames),
+      maxBytes(maxBytes), dirtyConsumer(memory.addDirtyConsumer()) {}
+
+RewindBuffer::~RewindBuffer() { memory.removeDirtyConsumer(dirtyConsumer); }
+
+void RewindBuffer::push() {
+  RewindFrame frame;
+  frame.cpu = cpu.saveSnapshot();
+  frame.randomState = memory.getRandomState();
+  const DirtyRegions dirty = memory.consumeDirty(dirtyConsumer);
+  if (frames.empty()) {
+    for (size_t page = 0; page < 0x100; page++) {
+      std::memcpy(&head[page << 8], memory.getPage(page), 0x100);
+    }
+  } else {
+    encode(frame.delta, dirty);
+  }
+  bytes += frame.delta.size();
+  frames.push_back(std::move(frame));
+
+  // O novo quadro mais antigo não precisa mais da diferença para o anterior
+  while (frames.size() > maxFrames ||
+         (bytes > maxBytes && frames.size() > 1)) {
+    frames.pop_front();
+    bytes -= frames.front().delta.size();
+    std::vector<uint8_t>().swap(frames.front().delta);
+  }
+}
+
+bool RewindBuffer::rewind() {
+  if (frames.empty()) {
+    return false;
+  }
+  if (frames.size() == 1) {
+    restoreTop();
+    return false;
+  }
+  decode(frames.back().delta);
+  bytes -= frames.back().delta.size();
+  frames.pop_back();
+  restoreTop();
+  return true;
+}
+
+void RewindBuffer::clear() {
+  frames.clear();
+  bytes = 0;
+}
+
+size_t RewindBuffer::getFrames() const { return frames.size(); }
+
+size_t RewindBuffer::getBytes() const { return bytes; }
+
+// Atualiza "head" para a memória atual e gera a diferença; linhas não
+// escritas desde o último quadro e páginas iguais viram uma sequência de
+// zeros sem comparação byte a byte
+void RewindBuffer::encode(std::vector<uint8_t> &delta,
+                          const DirtyRegions &dirty) {
+  uint32_t zeros = 0;
+  std::vector<uint8_t> literal;
+  auto flush = [&]() {
+    putVarint(delta, zeros);
+    putVarint(delta, literal.size());
+    delta.insert(delta.end(), literal.begin(), literal.end());
+    zeros = 0;
+    literal.clear();
+  };
+
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t *current = memory.getPage(page);
+    uint8_t *previous = &head[page << 8];
+    if (!dirty.isPageDirty(page) ||
+        std::memcmp(current, previous, 0x100) == 0) {
+      if (!literal.empty()) {
+        flush();
+      }
+      zeros += 0x100;
+      continue;
+    }
+    for (size_t i = 0; i < 0x100; i++) {
+      const uint8_t difference = current[i] ^ previous[i];
+      previous[i] = current[i];
+      if (difference == 0) {
+        if (!literal.empty()) {
+          flush();
+        }
+        zeros++;
+      } else {
+        literal.push_back(difference);
+      }
+    }
+  }
+  if (!literal.empty()) {
+    flush();
+  }
+}
+
+void RewindBuffer::decode(const std::vector<uint8_t> &delta) {
+  size_t pos = 0;
+  size_t address = 0;
+  while (pos < delta.size()) {
+    address += getVarint(delta, pos);
+    const uint32_t length = getVarint(delta, pos);
+    for (uint32_t i = 0; i < length && address < head.size(); i++) {
+      head[address++] ^= delta[pos++];
+    }
+  }
+}
+
+void RewindBuffer::restoreTop() {
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t *saved = &head[page << 8];
+    if (std::memcmp(memory.getPage(page), saved, 0x100) != 0) {
+      memory.restorePage(page, saved);
+    }
+  }
+  // A memória voltou a ser igual a "head"
+  memory.consumeDirty(dirtyConsumer);
+  memory.setRandomSeed(frames.back().randomState);
+  cpu.loadSnapshot(frames.back().cpu);
+}
@@ -0,0 +1,36 @@
+#include "RomImage.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+RomImage::RomImage(const std::string &path) : path(path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0) {
+    size = info.st_size;
+    if (size == 0) {
+      open = true;
+    } else {
+      void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        bytes = static_cast<const uint8_t *>(mapped);
+        open = true;
+      }
+    }
+  }
+  if (!open) {
+    size = 0;
+  }
+  // O mapeamento continua válido sem o descritor
+  close(fd);
+}
+
+RomImage::~RomImage() {
+  if (bytes != nullptr) {
+    munmap(const_cast<uint8_t *>(bytes), size);
+  }
+}
@@ -0,0 +1,58 @@
+#include "SaveState.hpp"
+#include <cstring>
+
+SaveStates::SaveStates(Cpu &cpu, Memory &memory)
+    : cpu(cpu), memory(memory), dirtyConsumer(memory.addDirtyConsumer()) {}
+
+SaveStates::~SaveStates() { memory.removeDirtyConsumer(dirtyConsumer); }
+
+std::shared_ptr<const SaveState> SaveStates::save() {
+  std::shared_ptr<SaveState> state = std::make_shared<SaveState>();
+  state->cpu = cpu.saveSnapshot();
+  state->randomState = memory.getRandomState();
+  state->copiedPages = 0;
+
+  const DirtyRegions dirty = memory.consumeDirty(dirtyConsumer);
+  for (size_t page = 0; page < 0x100; page++) {
+    const uint8_t *bytes = memory.getPage(page);
+    // Páginas escritas com os mesmos valores continuam compartilhadas
+    if (hasBase && (!dirty.isPageDirty(page) ||
+                    std::memcmp(base[page]->data(), bytes, 0x100) == 0)) {
+      state->pages[page] = base[page];
+      continue;
+    }
+    auto copy = std::make_shared<std::array<uint8_t, 0x100>>();
+    std::memcpy(copy->data(), bytes, 0x100);
+    state->pages[page] = copy;
+    state->copiedPages++;
+  }
+
+  base = state->pages;
+  hasBase = true;
+  copiedPages += state->copiedPages;
+  return state;
+}
+
+void SaveStates::load(const SaveState &state) {
+  const DirtyRegions dirty = memory.consumeDirty(dirtyConsumer);
+  for (size_t page = 0; page < 0x100; page++) {
+    // Mesmo ponteiro da base e sem escritas: a página já está no estado
+    if (hasBase && base[page] == state.pages[page] &&
+        !dirty.isPageDirty(page)) {
+      continue;
+    }
+    memory.restorePage(page, state.pages[page]->data());
+    restoredPages++;
+  }
+
+  base = state.pages;
+  hasBase = true;
+  // As páginas regravadas já estão iguais à nova base
+  memory.consumeDirty(dirtyConsumer);
+  memory.setRandomSeed(state.randomState);
+  cpu.loadSnapshot(state.cpu);
+}
+
+uint64_t SaveStates::getCopiedPages() const { return copiedPages; }
+
+uint64_t SaveStates::getRestoredPages() const { return restoredPages; }
@@ -0,0 +1,77 @@
+#include "Scheduler.hpp"
+#include <algorithm>
+
+Scheduler::Scheduler() {}
+
+Scheduler::~Scheduler() {}
+
+bool Scheduler::later(const Event &a, const Event &b) {
+  return a.cycle != b.cycle ? a.cycle > b.cycle : a.id > b.id;
+}
+
+EventId Scheduler::schedule(uint64_t cycle, ScheduledDevice *device,
+                            uint32_t tag) {
+  heap.push_back({cycle, nextId, device, tag});
+  std::push_heap(heap.begin(), heap.end(), later);
+  return nextId++;
+}
+
+// Cancelamentos são raros (poucos dispositivos): remoção linear
+void Scheduler::cancel(EventId id) {
+  auto it = std::find_if(heap.begin(), heap.end(),
+                         [id](const Event &event) { return event.id == id; });
+  if (it != heap.end()) {
+    heap.erase(it);
+    std::make_heap(heap.begin(), heap.end(), later);
+  }
+}
+
+void Scheduler::cancelAll(ScheduledDevice *device) {
+  heap.erase(std::remove_if(heap.begin(), heap.end(),
+                            [device](const Event &event) {
+                              return event.device == device;
+                            }),
+             heap.end());
+  std::make_heap(heap.begin(), heap.end(), later);
+}
+
+void Scheduler::clear() { heap.clear(); }
+
+void Scheduler::dispatch(uint64_t cycle) {
+  while (!heap.empty() && heap.front().cycle <= cycle) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const Event event = heap.back();
+    heap.pop_back();
+    event.device->onEvent(event.cycle, event.tag, *this);
+  }
+}
+
+void Scheduler::rebase(uint64_t origin) {
+  for (Event &event : heap) {
+    event.cycle = event.cycle > origin ? event.cycle - origin : 0;
+  }
+  // Eventos levados ao ciclo 0 voltam a ser ordenados pelo id
+  std::make_heap(heap.begin(), heap.end(), later);
+}
+
+std::vector<ScheduledEvent> Scheduler::saveEvents(uint64_t origin) const {
+  std::vector<ScheduledEvent> events;
+  events.reserve(heap.size());
+  for (const Event &event : heap) {
+    events.push_back({event.cycle > origin ? event.cycle - origin : 0,
+                      event.id, event.device, event.tag});
+  }
+  return events;
+}
+
+void Scheduler::restoreEvents(const std::vector<ScheduledEvent> &events,
+                              uint64_t origin) {
+  heap.clear();
+  for (const ScheduledEvent &event : events) {
+    heap.push_back({origin + event.delay, event.id, event.device, event.tag});
+    nextId = std::max(nextId, event.id + 1);
+  }
+  std::make_heap(heap.begin(), heap.end(), later);
+}
+
+size_t Scheduler::size() const { return heap.size(); }
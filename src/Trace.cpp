@@ -0,0 +1,230 @@
+#include "Trace.hpp"
+#include "Opcodes.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#include <initializer_list>
+#include <unistd.h>
+
+TraceBuffer::TraceBuffer() : records(CAPACITY) {}
+
+TraceBuffer::~TraceBuffer() {}
+
+size_t TraceBuffer::size() const {
+  return head < CAPACITY ? static_cast<size_t>(head) : CAPACITY;
+}
+
+const TraceRecord &TraceBuffer::at(size_t i) const {
+  return records[(head - size() + i) & (CAPACITY - 1)];
+}
+
+void TraceBuffer::clear() { head = 0; }
+
+namespace {
+
+// Escrita sem alocação (formatação usada também no tratamento de sinais)
+void putChars(char *&out, const char *text) {
+  while (*text != '\0') {
+    *out++ = *text++;
+  }
+}
+
+void putHex(char *&out, unsigned value, int digits) {
+  static const char hex[] = "0123456789ABCDEF";
+  for (int i = digits - 1; i >= 0; i--) {
+    *out++ = hex[(value >> (i * 4)) & 0x0F];
+  }
+}
+
+void putDec(char *&out, uint64_t value) {
+  char digits[20];
+  int size = 0;
+  do {
+    digits[size++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+  while (size > 0) {
+    *out++ = digits[--size];
+  }
+}
+
+void padTo(char *&out, const char *begin, size_t column) {
+  while (static_cast<size_t>(out - begin) < column) {
+    *out++ = ' ';
+  }
+}
+
+// Opcodes não oficiais têm o nome iniciado por "*" (como no log do nestest)
+bool isDocumented(uint8_t opcode) { return opcodesList[opcode][0] != '*'; }
+
+bool isAccumulatorMode(uint8_t opcode) {
+  return opcode == 0x0A || opcode == 0x2A || opcode == 0x4A || opcode == 0x6A;
+}
+
+} // namespace
+
+size_t TraceBuffer::format(const TraceRecord &record, char *out) {
+  char *begin = out;
+  const uint8_t size = operandSize(record.opcode);
+
+  putHex(out, record.pc, 4);
+  putChars(out, "  ");
+  putHex(out, record.opcode, 2);
+  for (uint8_t i = 0; i < size; i++) {
+    *out++ = ' ';
+    putHex(out, (record.operand >> (i * 8)) & 0xFF, 2);
+  }
+
+  // O "*" dos não oficiais fica uma coluna antes do mnemônico
+  const std::string &label = opcodesList[record.opcode];
+  const size_t labelSize = isDocumented(record.opcode) ? 3 : 4;
+  padTo(out, begin, 19 - labelSize);
+  for (size_t i = 0; i < labelSize; i++) {
+    *out++ = label[i];
+  }
+  *out++ = ' ';
+
+  switch (opcodeInfo[record.opcode].addrMode) {
+  case ADDR_MODE::IMMEDIATE:
+    putChars(out, "#$");
+    putHex(out, record.operand, 2);
+    break;
+  case ADDR_MODE::ZEROPAGE:
+  case ADDR_MODE::ZEROPAGE_X:
+  case ADDR_MODE::ZEROPAGE_Y:
+    *out++ = '$';
+    putHex(out, record.operand, 2);
+    break;
+  case ADDR_MODE::ABSOLUTE:
+  case ADDR_MODE::ABSOLUTE_X:
+  case ADDR_MODE::ABSOLUTE_Y:
+    *out++ = '$';
+    putHex(out, record.operand, 4);
+    break;
+  case ADDR_MODE::INDIRECT:
+    putChars(out, "($");
+    putHex(out, record.operand, 4);
+    *out++ = ')';
+    break;
+  case ADDR_MODE::INDIRECT_X:
+    putChars(out, "($");
+    putHex(out, record.operand, 2);
+    putChars(out, ",X)");
+    break;
+  case ADDR_MODE::INDIRECT_Y:
+    putChars(out, "($");
+    putHex(out, record.operand, 2);
+    putChars(out, "),Y");
+    break;
+  case ADDR_MODE::RELATIVE:
+    *out++ = '$';
+    putHex(out,
+           static_cast<uint16_t>(record.pc + 2 +
+                                 static_cast<int8_t>(record.operand & 0xFF)),
+           4);
+    break;
+  case ADDR_MODE::NONE:
+    if (isAccumulatorMode(record.opcode)) {
+      *out++ = 'A';
+    }
+    break;
+  }
+  switch (opcodeInfo[record.opcode].addrMode) {
+  case ADDR_MODE::ZEROPAGE_X:
+  case ADDR_MODE::ABSOLUTE_X:
+    putChars(out, ",X");
+    break;
+  case ADDR_MODE::ZEROPAGE_Y:
+  case ADDR_MODE::ABSOLUTE_Y:
+    putChars(out, ",Y");
+    break;
+  default:
+    break;
+  }
+
+  padTo(out, begin, 48);
+  putChars(out, "A:");
+  putHex(out, record.AC, 2);
+  putChars(out, " X:");
+  putHex(out, record.X, 2);
+  putChars(out, " Y:");
+  putHex(out, record.Y, 2);
+  putChars(out, " P:");
+  putHex(out, record.SR, 2);
+  putChars(out, " SP:");
+  putHex(out, record.SP, 2);
+  putChars(out, " CYC:");
+  putDec(out, record.cycle);
+  *out++ = '\n';
+  return out - begin;
+}
+
+void TraceBuffer::dump(std::ostream &out, size_t n) const {
+  char line[LINE_SIZE];
+  const size_t count = std::min(n, size());
+  for (size_t i = size() - count; i < size(); i++) {
+    out.write(line, format(at(i), line));
+  }
+}
+
+bool TraceBuffer::dumpToFile(const std::string &path, size_t n) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  dump(file, n);
+  return true;
+}
+
+namespace {
+
+bool writeAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+} // namespace
+
+void TraceBuffer::dumpToFd(int fd, size_t n) const {
+  char line[LINE_SIZE];
+  const size_t count = std::min(n, size());
+  for (size_t i = size() - count; i < size(); i++) {
+    if (!writeAll(fd, line, format(at(i), line))) {
+      return;
+    }
+  }
+}
+
+namespace {
+
+// Buffer despejado pelo tratamento de sinais
+const TraceBuffer *crashTrace = nullptr;
+
+void crashHandler(int signal) {
+  static const char header[] =
+      "\nbyteNES: fatal signal, last executed instructions:\n";
+  if (crashTrace != nullptr &&
+      writeAll(STDERR_FILENO, header, sizeof(header) - 1)) {
+    crashTrace->dumpToFd(STDERR_FILENO);
+  }
+  // Repassa o sinal com o tratamento padrão (core dump, código de saída)
+  std::signal(signal, SIG_DFL);
+  std::raise(signal);
+}
+
+} // namespace
+
+void TraceBuffer::installCrashHandler(const TraceBuffer *buffer) {
+  crashTrace = buffer;
+  for (int signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT}) {
+    std::signal(signal, crashHandler);
+  }
+}
@@ -0,0 +1,295 @@
+#include "TraceCompare.hpp"
+#include "Trace.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Leitura do log em blocos de 1 MiB, linha a linha, sem alocação por linha
+class LineReader {
+public:
+  explicit LineReader(const std::string &path)
+      : file(std::fopen(path.c_str(), "rb")), buffer(1 << 20) {}
+  ~LineReader() {
+    if (file != nullptr) {
+      std::fclose(file);
+    }
+  }
+
+  bool isOpen() const { return file != nullptr; }
+
+  // Próxima linha sem o '\n' (e sem '\r'); false no fim do arquivo
+  bool next(const char *&line, size_t &size) {
+    for (;;) {
+      const char *start = buffer.data() + begin;
+      const char *newline =
+          static_cast<const char *>(std::memchr(start, '\n', end - begin));
+      if (newline != nullptr) {
+        line = start;
+        size = newline - start;
+        begin += size + 1;
+        trim(line, size);
+        return true;
+      }
+      if (eof) {
+        if (begin == end) {
+          return false;
+        }
+        // Última linha sem '\n'
+        line = start;
+        size = end - begin;
+        begin = end;
+        trim(line, size);
+        return true;
+      }
+      fill();
+    }
+  }
+
+private:
+  FILE *file;
+  std::vector<char> buffer;
+  size_t begin{};
+  size_t end{};
+  bool eof{false};
+
+  // Move o resto da linha para o início e lê o próximo bloco
+  void fill() {
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    if (end == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+    const size_t read =
+        std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+    end += read;
+    eof = read == 0;
+  }
+
+  static void trim(const char *line, size_t &size) {
+    if (size > 0 && line[size - 1] == '\r') {
+      size--;
+    }
+  }
+};
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool parseHex(const char *text, const char *end, int digits, unsigned &out) {
+  if (end - text < digits) {
+    return false;
+  }
+  out = 0;
+  for (int i = 0; i < digits; i++) {
+    const int digit = hexDigit(text[i]);
+    if (digit < 0) {
+      return false;
+    }
+    out = (out << 4) | digit;
+  }
+  return true;
+}
+
+// Posição logo após " <name>" (precedido de espaço para não confundir
+// "P:" com "SP:" ou com "PPU:"), ou nullptr
+const char *findField(const char *line, const char *end, const char *name) {
+  const size_t size = std::strlen(name);
+  for (const char *p = line; p + size < end; p++) {
+    if (*p == ' ' && std::memcmp(p + 1, name, size) == 0) {
+      return p + 1 + size;
+    }
+  }
+  return nullptr;
+}
+
+// Os campos aparecem em ordem: a busca continua de onde a anterior parou
+bool parseRegister(const char *&cursor, const char *end, const char *name,
+                   uint8_t &out) {
+  const char *field = findField(cursor, end, name);
+  unsigned value;
+  if (field == nullptr || !parseHex(field, end, 2, value)) {
+    return false;
+  }
+  out = value;
+  cursor = field + 2;
+  return true;
+}
+
+bool parseLine(const char *line, size_t size, ReferenceState &state) {
+  const char *end = line + size;
+  unsigned pc;
+  if (!parseHex(line, end, 4, pc)) {
+    return false;
+  }
+  state.pc = pc;
+  // Registradores depois da desmontagem (coluna 48 no nestest)
+  const char *cursor = line + 4;
+  if (!parseRegister(cursor, end, "A:", state.AC) ||
+      !parseRegister(cursor, end, "X:", state.X) ||
+      !parseRegister(cursor, end, "Y:", state.Y) ||
+      !parseRegister(cursor, end, "P:", state.SR) ||
+      !parseRegister(cursor, end, "SP:", state.SP)) {
+    return false;
+  }
+
+  // Opcional; no nestest vem depois de "PPU:"
+  const char *cycle = findField(cursor, end, "CYC:");
+  state.hasCycle = cycle != nullptr && cycle < end && *cycle >= '0' &&
+                   *cycle <= '9';
+  state.cycle = 0;
+  if (state.hasCycle) {
+    for (; cycle < end && *cycle >= '0' && *cycle <= '9'; cycle++) {
+      state.cycle = state.cycle * 10 + (*cycle - '0');
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TraceComparer::TraceComparer(Cpu &cpu) : cpu(cpu) {}
+
+TraceComparer::~TraceComparer() {}
+
+void TraceComparer::setStatusMask(uint8_t mask) { statusMask = mask; }
+
+void TraceComparer::setCompareCycles(bool enable) { compareCycles = enable; }
+
+void TraceComparer::setContextLines(size_t lines) { contextLines = lines; }
+
+bool TraceComparer::run(const std::string &path, uint64_t maxLines) {
+  lines = 0;
+  error.clear();
+  mismatch = false;
+  context.assign(contextLines, std::string());
+  contextHead = 0;
+
+  LineReader reader(path);
+  if (!reader.isOpen()) {
+    error = "Could not open " + path;
+    return false;
+  }
+
+  Memory &memory = cpu.getMemory();
+  // Ciclo da referência - ciclo da CPU (definido pela primeira linha)
+  int64_t cycleOffset = 0;
+  const char *line;
+  size_t size;
+  while (lines < maxLines && reader.next(line, size)) {
+    if (size == 0) {
+      continue;
+    }
+    ReferenceState reference;
+    if (!parseLine(line, size, reference)) {
+      error = "Could not parse line " + std::to_string(lines + 1) + ": " +
+              std::string(line, size);
+      return false;
+    }
+
+    if (lines == 0) {
+      cpu.setState({reference.pc, reference.SP, reference.AC, reference.X,
+                    reference.Y, reference.SR});
+      cycleOffset = static_cast<int64_t>(reference.cycle - cpu.getCycles());
+    }
+    lines++;
+
+    const CpuState state = cpu.getState();
+    const uint64_t cycles = cpu.getCycles() + cycleOffset;
+    const char *differs = nullptr;
+    if (state.PC != reference.pc) {
+      differs = "PC";
+    } else if (state.AC != reference.AC) {
+      differs = "A";
+    } else if (state.X != reference.X) {
+      differs = "X";
+    } else if (state.Y != reference.Y) {
+      differs = "Y";
+    } else if (((state.SR ^ reference.SR) & statusMask) != 0) {
+      differs = "P";
+    } else if (state.SP != reference.SP) {
+      differs = "SP";
+    } else if (compareCycles && reference.hasCycle &&
+               cycles != reference.cycle) {
+      differs = "CYC";
+    }
+
+    if (differs != nullptr) {
+      TraceRecord record;
+      record.cycle = cycles;
+      record.pc = state.PC;
+      record.opcode = memory.peek(state.PC);
+      record.operand = memory.peek(state.PC + 1) |
+                       (memory.peek(state.PC + 2) << 8);
+      record.AC = state.AC;
+      record.X = state.X;
+      record.Y = state.Y;
+      record.SP = state.SP;
+      record.SR = state.SR;
+      char formatted[TraceBuffer::LINE_SIZE];
+      size_t formattedSize = TraceBuffer::format(record, formatted);
+      if (formattedSize > 0 && formatted[formattedSize - 1] == '\n') {
+        formattedSize--;
+      }
+
+      mismatch = true;
+      mismatchLine = lines;
+      field = differs;
+      expected.assign(line, size);
+      actual.assign(formatted, formattedSize);
+      return false;
+    }
+
+    remember(line, size);
+    // Interrupções não são atendidas: cada linha é uma instrução
+    cpu.next();
+  }
+  return true;
+}
+
+uint64_t TraceComparer::getLines() { return lines; }
+
+bool TraceComparer::hasMismatch() { return mismatch; }
+
+void TraceComparer::report(std::ostream &out) {
+  out << std::dec << "| Lines compared: " << lines << "\n";
+  if (!error.empty()) {
+    out << "| " << error << "\n";
+    return;
+  }
+  if (!mismatch) {
+    out << "| No divergences\n";
+    return;
+  }
+
+  out << "| Divergence at line " << mismatchLine << " (" << field << ")\n";
+  // Contexto do mais antigo para o mais recente
+  for (size_t i = 0; i < context.size(); i++) {
+    const std::string &previous = context[(contextHead + i) % context.size()];
+    if (!previous.empty()) {
+      out << "|        " << previous << "\n";
+    }
+  }
+  out << "|   ref: " << expected << "\n";
+  out << "|   emu: " << actual << "\n";
+}
+
+// Reaproveita as strings do buffer: sem alocação depois das primeiras linhas
+void TraceComparer::remember(const char *line, size_t size) {
+  if (context.empty()) {
+    return;
+  }
+  context[contextHead].assign(line, size);
+  contextHead = (contextHead + 1) % context.size();
+}